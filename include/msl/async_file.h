@@ -0,0 +1,677 @@
+#ifndef MSL_ASYNC_FILE_H__
+#define MSL_ASYNC_FILE_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#define MSL_ASYNC_FILE_HAS_IO_URING
+#endif
+#endif
+
+namespace msl
+{
+
+struct async_io_result
+{
+	std::size_t bytes{}; // bytes transferred; short reads mean EOF
+	std::error_code error{};
+
+	explicit operator bool() const { return !error; }
+};
+
+using async_io_callback = std::function<void(async_io_result)>;
+
+enum class async_file_backend
+{
+	thread_pool,
+	io_uring,
+};
+
+struct async_file_options
+{
+	std::size_t workers{2}; // thread-pool backend worker count
+	unsigned queue_depth{64}; // io_uring submission queue size (max in-flight operations)
+	bool use_io_uring{true}; // try io_uring first on Linux, falling back to the thread pool
+};
+
+namespace details
+{
+struct async_file_state
+{
+	std::mutex mutex;
+	std::condition_variable idle;
+	std::size_t pending{0};
+	bool retired{false}; // the async_file was destroyed from an I/O thread: the engine deletes itself when idle
+	file_ptr file; // the retired file, kept open for the operations still in flight
+	#ifdef _WIN32
+	std::mutex file_mutex; // stdio has no positional I/O, so seek+transfer must be serialized
+	#endif
+};
+
+struct async_file_op
+{
+	bool write{};
+	std::FILE * file{};
+	std::uint64_t offset{};
+	std::byte * data{};
+	std::size_t size{};
+	std::size_t done{};
+	async_io_callback callback;
+	async_file_state * state{};
+	#ifdef MSL_ASYNC_FILE_HAS_IO_URING
+	iovec iov{};
+	#endif
+};
+
+//! @brief run the user callback, destroy the operation and wake wait_idle() callers
+//! @return true if this was the last operation of a retired engine, which the calling I/O thread must now delete
+inline bool async_file_finish(async_file_op * op, std::error_code error)
+{
+	auto * state = op->state;
+	if (op->callback)
+		op->callback({op->done, error});
+	delete op;
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if (--state->pending != 0)
+		return false;
+	state->idle.notify_all();
+	return state->retired;
+}
+
+//! @brief blocking positional transfer used by the thread-pool backend
+inline std::error_code async_file_transfer(async_file_op & op)
+{
+	#ifdef _WIN32
+	std::lock_guard<std::mutex> lock(op.state->file_mutex);
+	if (_fseeki64(op.file, static_cast<long long>(op.offset), SEEK_SET) != 0)
+		return {errno, std::generic_category()};
+	op.done = op.write ? std::fwrite(op.data, 1, op.size, op.file) : std::fread(op.data, 1, op.size, op.file);
+	if (std::ferror(op.file))
+	{
+		std::clearerr(op.file);
+		return std::make_error_code(std::errc::io_error);
+	}
+	return {};
+	#else
+	const auto fd = ::fileno(op.file);
+	while (op.done < op.size)
+	{
+		const auto offset = static_cast<off_t>(op.offset + op.done);
+		const auto n = op.write ? ::pwrite(fd, op.data + op.done, op.size - op.done, offset)
+								: ::pread(fd, op.data + op.done, op.size - op.done, offset);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0)
+			return {errno, std::system_category()};
+		if (n == 0)
+			break;
+		op.done += static_cast<std::size_t>(n);
+	}
+	return {};
+	#endif
+}
+
+class async_file_engine
+{
+public:
+	virtual ~async_file_engine() = default;
+	virtual void submit(async_file_op * op) = 0;
+	//! @brief true on one of the engine's own I/O threads
+	virtual bool on_engine_thread() const = 0;
+
+	//! @brief pending count and idle signal of the file, owned here so that they can outlive a retired async_file
+	async_file_state state;
+};
+
+class async_file_pool_engine final : public async_file_engine
+{
+public:
+	explicit async_file_pool_engine(std::size_t workers)
+	{
+		workers = (std::max)(workers, std::size_t{1});
+		for (std::size_t i = 0; i < workers; ++i)
+			m_threads_.emplace_back([this] { run(); });
+	}
+
+	~async_file_pool_engine() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex_);
+			m_stop_ = true;
+		}
+		m_cv_.notify_all();
+		for (auto & th : m_threads_)
+		{
+			if (th.get_id() == std::this_thread::get_id())
+				th.detach(); // deleted by this worker once retired: it returns right after the destructor
+			else
+				th.join();
+		}
+	}
+
+	bool on_engine_thread() const override
+	{
+		return std::any_of(m_threads_.begin(), m_threads_.end(), [](const std::thread & th) { return th.get_id() == std::this_thread::get_id(); });
+	}
+
+	void submit(async_file_op * op) override
+	{
+		// notify under the lock: once it is released the operation may complete and retire the engine
+		std::lock_guard<std::mutex> lock(m_mutex_);
+		m_queue_.push_back(op);
+		m_cv_.notify_one();
+	}
+
+private:
+	void run()
+	{
+		for (;;)
+		{
+			async_file_op * op;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex_);
+				m_cv_.wait(lock, [this] { return m_stop_ || !m_queue_.empty(); });
+				if (m_queue_.empty())
+					return;
+				op = m_queue_.front();
+				m_queue_.pop_front();
+			}
+			const auto error = async_file_transfer(*op);
+			if (async_file_finish(op, error))
+			{
+				delete this;
+				return;
+			}
+		}
+	}
+
+	std::mutex m_mutex_;
+	std::condition_variable m_cv_;
+	std::deque<async_file_op *> m_queue_;
+	bool m_stop_{false};
+	std::vector<std::thread> m_threads_;
+};
+
+#ifdef MSL_ASYNC_FILE_HAS_IO_URING
+//! @brief io_uring engine driven through raw syscalls; a dedicated thread reaps completions
+class async_file_uring_engine final : public async_file_engine
+{
+public:
+	//! @brief returns nullptr if the kernel refuses io_uring (old kernel, seccomp, sysctl)
+	static std::unique_ptr<async_file_uring_engine> create(unsigned depth)
+	{
+		std::unique_ptr<async_file_uring_engine> engine(new async_file_uring_engine());
+		if (!engine->setup((std::max)(depth, 1u)))
+			return nullptr;
+		engine->m_thread_ = std::thread([raw = engine.get()] { raw->reap(); });
+		return engine;
+	}
+
+	~async_file_uring_engine() override
+	{
+		if (on_engine_thread())
+			m_thread_.detach(); // deleted by the reaper once retired: it returns right after the destructor
+		else if (m_thread_.joinable())
+		{
+			// a NOP with user_data 0 tells the reaper to exit once everything before it completed
+			std::unique_lock<std::mutex> lock(m_mutex_);
+			m_cv_.wait(lock, [this] { return m_inflight_ == 0; });
+			if (!m_failure_) // a failed reaper already returned
+				push_locked(IORING_OP_NOP, 0, nullptr);
+			lock.unlock();
+			m_thread_.join();
+		}
+		if (m_sqes_ != MAP_FAILED)
+			::munmap(m_sqes_, m_sqes_len_);
+		if (m_cq_ptr_ != MAP_FAILED && m_cq_ptr_ != m_sq_ptr_)
+			::munmap(m_cq_ptr_, m_cq_len_);
+		if (m_sq_ptr_ != MAP_FAILED)
+			::munmap(m_sq_ptr_, m_sq_len_);
+		if (m_ring_fd_ >= 0)
+			::close(m_ring_fd_);
+	}
+
+	void submit(async_file_op * op) override
+	{
+		std::unique_lock<std::mutex> lock(m_mutex_);
+		if (m_failure_)
+		{
+			// the reaper gave up on the ring: nothing would ever complete this operation
+			const auto error = m_failure_;
+			lock.unlock();
+			async_file_finish(op, error);
+			return;
+		}
+		if (on_engine_thread())
+		{
+			// only the reaper frees slots: a callback submitting into a full ring queues the operation instead of waiting
+			if (m_inflight_ >= m_entries_ || !m_backlog_.empty())
+			{
+				m_backlog_.push_back(op);
+				return;
+			}
+		}
+		else
+			m_cv_.wait(lock, [this] { return m_inflight_ < m_entries_; }); // never overflow the completion queue
+		++m_inflight_;
+		if (push_locked(op->write ? IORING_OP_WRITEV : IORING_OP_READV, ::fileno(op->file), op))
+			m_pending_.insert(op);
+		else
+		{
+			const std::error_code error(errno, std::system_category());
+			--m_inflight_;
+			lock.unlock();
+			m_cv_.notify_all();
+			// submit() never completes the last operation of a retired engine: the caller's own one is still pending
+			async_file_finish(op, error);
+		}
+	}
+
+	bool on_engine_thread() const override { return m_thread_.get_id() == std::this_thread::get_id(); }
+
+private:
+	async_file_uring_engine() = default;
+
+	static int enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+	}
+
+	bool setup(unsigned depth)
+	{
+		io_uring_params params{};
+		m_ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, depth, &params));
+		if (m_ring_fd_ < 0)
+			return false;
+
+		m_entries_ = params.sq_entries;
+		m_sq_len_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		m_cq_len_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (single_mmap)
+			m_sq_len_ = m_cq_len_ = (std::max)(m_sq_len_, m_cq_len_);
+
+		m_sq_ptr_ = ::mmap(nullptr, m_sq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd_, IORING_OFF_SQ_RING);
+		if (m_sq_ptr_ == MAP_FAILED)
+			return false;
+		m_cq_ptr_ = single_mmap ? m_sq_ptr_
+								: ::mmap(nullptr, m_cq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd_, IORING_OFF_CQ_RING);
+		if (m_cq_ptr_ == MAP_FAILED)
+			return false;
+		m_sqes_len_ = params.sq_entries * sizeof(io_uring_sqe);
+		m_sqes_ = ::mmap(nullptr, m_sqes_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd_, IORING_OFF_SQES);
+		if (m_sqes_ == MAP_FAILED)
+			return false;
+
+		auto * sq = static_cast<char *>(m_sq_ptr_);
+		auto * cq = static_cast<char *>(m_cq_ptr_);
+		m_sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+		m_sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+		m_sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+		m_cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+		m_cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+		m_cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+		m_cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+		return true;
+	}
+
+	//! @brief queue one SQE and submit it; the kernel consumes it synchronously so the SQ never fills up
+	bool push_locked(std::uint8_t opcode, int fd, async_file_op * op)
+	{
+		const auto tail = *m_sq_tail_;
+		const auto index = tail & m_sq_mask_;
+		auto * sqe = static_cast<io_uring_sqe *>(m_sqes_) + index;
+		std::memset(sqe, 0, sizeof(*sqe));
+		sqe->opcode = opcode;
+		sqe->fd = fd;
+		sqe->user_data = reinterpret_cast<std::uint64_t>(op);
+		if (op)
+		{
+			op->iov.iov_base = op->data + op->done;
+			op->iov.iov_len = op->size - op->done;
+			sqe->off = op->offset + op->done;
+			sqe->addr = reinterpret_cast<std::uint64_t>(&op->iov);
+			sqe->len = 1;
+		}
+		m_sq_array_[index] = index;
+		std::atomic_ref<unsigned>(*m_sq_tail_).store(tail + 1, std::memory_order_release);
+
+		int ret;
+		while ((ret = enter(m_ring_fd_, 1, 0, 0)) < 0 && (errno == EINTR || errno == EAGAIN || errno == EBUSY))
+			std::this_thread::yield();
+		if (ret < 0)
+		{
+			std::atomic_ref<unsigned>(*m_sq_tail_).store(tail, std::memory_order_release); // not consumed: take it back
+			return false;
+		}
+		return true;
+	}
+
+	//! @brief complete op; returns true if the engine was retired and has to be deleted by the reaper
+	bool complete(async_file_op * op, int res)
+	{
+		// the lock also orders the submitter writes to *op, which travelled through the kernel
+		std::unique_lock<std::mutex> lock(m_mutex_);
+		std::error_code error;
+		if (res < 0)
+			error = {-res, std::system_category()};
+		else
+		{
+			op->done += static_cast<std::size_t>(res);
+			// short transfer: continue from where the kernel stopped, keeping the in-flight slot
+			if (res > 0 && op->done < op->size)
+			{
+				if (push_locked(op->write ? IORING_OP_WRITEV : IORING_OP_READV, ::fileno(op->file), op))
+					return false;
+				error = {errno, std::system_category()};
+			}
+		}
+		--m_inflight_;
+		m_pending_.erase(op);
+		// the freed slot goes to the operations queued by callbacks
+		std::vector<std::pair<async_file_op *, std::error_code>> failed;
+		while (!m_backlog_.empty() && m_inflight_ < m_entries_)
+		{
+			auto * next = m_backlog_.front();
+			m_backlog_.pop_front();
+			++m_inflight_;
+			if (push_locked(next->write ? IORING_OP_WRITEV : IORING_OP_READV, ::fileno(next->file), next))
+				m_pending_.insert(next);
+			else
+			{
+				--m_inflight_;
+				failed.emplace_back(next, std::error_code(errno, std::system_category()));
+			}
+		}
+		lock.unlock();
+		m_cv_.notify_all();
+		bool retired = false;
+		for (const auto & [next, push_error] : failed)
+			retired = async_file_finish(next, push_error) || retired;
+		return async_file_finish(op, error) || retired;
+	}
+
+	//! @brief the ring is unusable: fail every in-flight and queued operation; returns true if the engine was retired
+	bool fail_all(std::error_code error)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex_);
+		m_failure_ = error;
+		std::vector<async_file_op *> failed(m_pending_.begin(), m_pending_.end());
+		failed.insert(failed.end(), m_backlog_.begin(), m_backlog_.end());
+		m_pending_.clear();
+		m_backlog_.clear();
+		m_inflight_ = 0;
+		lock.unlock();
+		m_cv_.notify_all();
+		bool retired = false;
+		for (auto * op : failed)
+			retired = async_file_finish(op, error) || retired;
+		return retired;
+	}
+
+	void reap()
+	{
+		for (;;)
+		{
+			if (enter(m_ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0)
+			{
+				if (errno == EAGAIN || errno == EBUSY)
+					std::this_thread::yield();
+				else if (errno != EINTR)
+				{
+					// persistent failure (EBADF, ENOMEM, ...): spinning would leave every operation pending forever
+					if (fail_all({errno, std::system_category()}))
+						delete this;
+					return;
+				}
+			}
+
+			auto head = *m_cq_head_;
+			const auto tail = std::atomic_ref<unsigned>(*m_cq_tail_).load(std::memory_order_acquire);
+			bool stop = false;
+			while (head != tail)
+			{
+				const auto cqe = m_cqes_[head & m_cq_mask_];
+				std::atomic_ref<unsigned>(*m_cq_head_).store(++head, std::memory_order_release);
+				if (cqe.user_data == 0)
+					stop = true;
+				else if (complete(reinterpret_cast<async_file_op *>(cqe.user_data), cqe.res))
+				{
+					delete this;
+					return;
+				}
+			}
+			if (stop)
+				return;
+		}
+	}
+
+	int m_ring_fd_{-1};
+	unsigned m_entries_{0};
+	void * m_sq_ptr_{MAP_FAILED};
+	void * m_cq_ptr_{MAP_FAILED};
+	void * m_sqes_{MAP_FAILED};
+	std::size_t m_sq_len_{0};
+	std::size_t m_cq_len_{0};
+	std::size_t m_sqes_len_{0};
+	unsigned * m_sq_tail_{};
+	unsigned * m_sq_array_{};
+	unsigned m_sq_mask_{};
+	unsigned * m_cq_head_{};
+	unsigned * m_cq_tail_{};
+	unsigned m_cq_mask_{};
+	io_uring_cqe * m_cqes_{};
+
+	std::mutex m_mutex_; // guards the submission queue and m_inflight_
+	std::condition_variable m_cv_;
+	unsigned m_inflight_{0};
+	std::unordered_set<async_file_op *> m_pending_; // pushed to the ring and not completed yet
+	std::deque<async_file_op *> m_backlog_; // submitted by callbacks while the ring was full
+	std::error_code m_failure_; // set once the reaper gave up on the ring
+	std::thread m_thread_;
+};
+#endif
+} // namespace details
+
+//! @brief positional asynchronous reads/writes over a file_ptr
+//! @note buffers must stay valid until completion; callbacks run on an I/O thread
+class async_file
+{
+public:
+	class [[nodiscard]] awaitable
+	{
+	public:
+		awaitable(async_file & file, bool write, std::uint64_t offset, std::byte * data, std::size_t size) :
+			m_file_(file), m_write_(write), m_offset_(offset), m_data_(data), m_size_(size)
+		{
+		}
+
+		bool await_ready() const noexcept { return false; }
+		//! @return false when the operation completed synchronously (failed submit), so the caller resumes itself only
+		//! after async_file_finish dropped the pending count: resuming inline could destroy the file while it still counts
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			m_file_.submit(m_write_, m_offset_, m_data_, m_size_, [this, handle](async_io_result result) {
+				m_result_ = result;
+				if (m_stage_.exchange(stage::completed, std::memory_order_acq_rel) == stage::suspended)
+					handle.resume();
+			});
+			// whoever comes second owns the resume; once suspended is published, *this may already be gone
+			return m_stage_.exchange(stage::suspended, std::memory_order_acq_rel) != stage::completed;
+		}
+		async_io_result await_resume() const noexcept { return m_result_; }
+
+	private:
+		async_file & m_file_;
+		bool m_write_;
+		std::uint64_t m_offset_;
+		std::byte * m_data_;
+		std::size_t m_size_;
+		async_io_result m_result_{};
+		enum class stage
+		{
+			submitting,
+			suspended,
+			completed,
+		};
+		std::atomic<stage> m_stage_{stage::submitting};
+	};
+
+	explicit async_file(file_ptr file, async_file_options options = {}) : m_file_(std::move(file))
+	{
+		if (!m_file_)
+			return;
+		m_file_.flush(); // positional I/O bypasses stdio, so pending buffered writes go first
+		#ifdef MSL_ASYNC_FILE_HAS_IO_URING
+		if (options.use_io_uring)
+		{
+			if (auto engine = details::async_file_uring_engine::create(options.queue_depth))
+			{
+				m_engine_ = std::move(engine);
+				m_backend_ = async_file_backend::io_uring;
+				return;
+			}
+		}
+		#endif
+		m_engine_ = std::make_unique<details::async_file_pool_engine>(options.workers);
+	}
+	async_file(const std::string_view & filename, const std::string_view & mode = "rb", async_file_options options = {}) :
+		async_file(file_ptr(filename, mode), options)
+	{
+	}
+
+	async_file(const async_file &) = delete;
+	async_file & operator=(const async_file &) = delete;
+
+	//! @brief wait for every pending operation before closing the file
+	//! @note from inside one of its own callbacks (e.g. a coroutine owning the file) the destructor cannot wait, since
+	//! that thread completes the operations: the engine then keeps the file open and deletes itself after the last one
+	~async_file()
+	{
+		if (m_engine_ && m_engine_->on_engine_thread())
+		{
+			std::lock_guard<std::mutex> lock(m_engine_->state.mutex);
+			m_engine_->state.file = std::move(m_file_);
+			m_engine_->state.retired = true;
+			m_engine_.release(); // the running callback keeps pending above zero: its thread deletes the engine
+			return;
+		}
+		wait_idle();
+		m_engine_.reset();
+	}
+
+	bool is_open() const { return m_file_.is_open(); }
+	async_file_backend backend() const { return m_backend_; }
+
+	//! @brief number of submitted operations whose callback has not finished yet
+	std::size_t pending() const
+	{
+		if (!m_engine_)
+			return 0;
+		std::lock_guard<std::mutex> lock(m_engine_->state.mutex);
+		return m_engine_->state.pending;
+	}
+
+	//! @brief block until every submitted operation completed
+	//! @note returns at once when called from one of the file's own callbacks, whose thread has to complete them
+	void wait_idle()
+	{
+		if (!m_engine_ || m_engine_->on_engine_thread())
+			return;
+		auto & state = m_engine_->state;
+		std::unique_lock<std::mutex> lock(state.mutex);
+		state.idle.wait(lock, [&state] { return state.pending == 0; });
+	}
+
+	//! @brief read buffer.size() bytes at offset, then invoke callback on an I/O thread
+	void read(std::uint64_t offset, std::span<std::byte> buffer, async_io_callback callback)
+	{
+		submit(false, offset, buffer.data(), buffer.size(), std::move(callback));
+	}
+
+	//! @brief write the buffer at offset, then invoke callback on an I/O thread
+	void write(std::uint64_t offset, std::span<const std::byte> buffer, async_io_callback callback)
+	{
+		submit(true, offset, const_cast<std::byte *>(buffer.data()), buffer.size(), std::move(callback));
+	}
+
+	//! @brief co_await file.read(offset, buffer) yields the async_io_result
+	awaitable read(std::uint64_t offset, std::span<std::byte> buffer) { return {*this, false, offset, buffer.data(), buffer.size()}; }
+
+	//! @brief co_await file.write(offset, buffer) yields the async_io_result
+	awaitable write(std::uint64_t offset, std::span<const std::byte> buffer)
+	{
+		return {*this, true, offset, const_cast<std::byte *>(buffer.data()), buffer.size()};
+	}
+
+private:
+	void submit(bool write, std::uint64_t offset, std::byte * data, std::size_t size, async_io_callback callback)
+	{
+		if (!m_engine_)
+		{
+			if (callback)
+				callback({0, std::make_error_code(std::errc::bad_file_descriptor)});
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_engine_->state.mutex);
+			++m_engine_->state.pending;
+		}
+		auto * op = new details::async_file_op{};
+		op->write = write;
+		op->file = m_file_.get();
+		op->offset = offset;
+		op->data = data;
+		op->size = size;
+		op->callback = std::move(callback);
+		op->state = &m_engine_->state;
+		m_engine_->submit(op);
+	}
+
+	file_ptr m_file_;
+	async_file_backend m_backend_{async_file_backend::thread_pool};
+	std::unique_ptr<details::async_file_engine> m_engine_;
+}; // async_file
+
+} // namespace msl
+#endif // MSL_ASYNC_FILE_H__
@@ -0,0 +1,396 @@
+#ifndef MSL_ASYNC_LOG_H__
+#define MSL_ASYNC_LOG_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace msl
+{
+
+//! @brief what async_log_file::write does when the calling thread staging buffer is full
+enum class async_log_overflow
+{
+	drop, // discard the message and count it as dropped
+	block, // wait for the flusher thread to make room
+};
+
+struct async_log_options
+{
+	std::chrono::milliseconds flush_interval{50}; // max delay before staged bytes reach the file; clamped to at least 1ms
+	std::chrono::milliseconds sync_interval{0}; // group fsync period; 0 disables periodic fsync
+	std::size_t thread_buffer_size{64 * 1024}; // staging bytes per producer thread (rounded up to a power of two)
+	async_log_overflow overflow{async_log_overflow::drop};
+};
+
+struct async_log_stats
+{
+	std::uint64_t queued_bytes{}; // bytes currently staged and not yet written
+	std::uint64_t written_bytes{}; // bytes handed to the file
+	std::uint64_t dropped_bytes{};
+	std::uint64_t dropped_messages{};
+};
+
+namespace details
+{
+//! @brief single-producer/single-consumer byte ring owned by one writer thread
+class async_log_ring
+{
+public:
+	explicit async_log_ring(std::size_t capacity) :
+		m_capacity_(std::bit_ceil((std::max)(capacity, std::size_t{64}))), m_data_(new char[m_capacity_])
+	{
+	}
+
+	std::size_t capacity() const noexcept { return m_capacity_; }
+	std::size_t size() const noexcept { return m_head_.load(std::memory_order_acquire) - m_tail_.load(std::memory_order_acquire); }
+
+	//! @brief producer side: append the whole message or nothing
+	bool try_push(std::string_view bytes) noexcept
+	{
+		const auto head = m_head_.load(std::memory_order_relaxed);
+		const auto tail = m_tail_.load(std::memory_order_acquire);
+		if (m_capacity_ - (head - tail) < bytes.size())
+			return false;
+		const auto pos = head & (m_capacity_ - 1);
+		const auto first = (std::min)(bytes.size(), m_capacity_ - pos);
+		std::memcpy(m_data_.get() + pos, bytes.data(), first);
+		std::memcpy(m_data_.get(), bytes.data() + first, bytes.size() - first);
+		m_head_.store(head + bytes.size(), std::memory_order_release);
+		return true;
+	}
+
+	//! @brief consumer side: move every staged byte at the end of out
+	std::size_t drain_into(std::string & out)
+	{
+		const auto tail = m_tail_.load(std::memory_order_relaxed);
+		const auto head = m_head_.load(std::memory_order_acquire);
+		const auto n = static_cast<std::size_t>(head - tail);
+		if (n == 0)
+			return 0;
+		const auto pos = tail & (m_capacity_ - 1);
+		const auto first = (std::min)(n, m_capacity_ - pos);
+		out.append(m_data_.get() + pos, first);
+		out.append(m_data_.get(), n - first);
+		m_tail_.store(head, std::memory_order_release);
+		return n;
+	}
+
+	std::atomic<bool> orphaned{false}; // set when the owner thread exits
+
+private:
+	std::size_t m_capacity_;
+	std::unique_ptr<char[]> m_data_;
+	alignas(64) std::atomic<std::uint64_t> m_head_{0};
+	alignas(64) std::atomic<std::uint64_t> m_tail_{0};
+};
+
+//! @brief per-thread map of logger id -> staging ring; marks the rings orphaned at thread exit
+struct async_log_thread_cache
+{
+	struct entry
+	{
+		std::uint64_t owner;
+		async_log_ring * ring;
+		std::weak_ptr<async_log_ring> weak;
+	};
+	std::vector<entry> entries;
+
+	~async_log_thread_cache()
+	{
+		for (auto & e : entries)
+		{
+			if (auto ring = e.weak.lock())
+				ring->orphaned.store(true, std::memory_order_release);
+		}
+	}
+
+	static async_log_thread_cache & local()
+	{
+		thread_local async_log_thread_cache cache;
+		return cache;
+	}
+};
+} // namespace details
+
+//! @brief append-only log file written by a background flusher thread
+//! @note writers copy into their own lock-free staging ring; the flusher batches all rings into one file write
+class async_log_file
+{
+public:
+	explicit async_log_file(file_ptr file, async_log_options options = {}) : m_file_(std::move(file)), m_options_(options)
+	{
+		// a zero timeout would turn the flusher wait into a busy loop
+		m_options_.flush_interval = (std::max)(m_options_.flush_interval, std::chrono::milliseconds(1));
+		if (m_file_)
+			m_thread_ = std::thread([this] { run(); });
+	}
+	explicit async_log_file(const std::string_view & filename, async_log_options options = {}) :
+		async_log_file(file_ptr(filename, "ab"), options)
+	{
+	}
+
+	async_log_file(const async_log_file &) = delete;
+	async_log_file & operator=(const async_log_file &) = delete;
+
+	//! @brief stop the flusher thread after draining every staged byte
+	~async_log_file()
+	{
+		if (!m_thread_.joinable())
+			return;
+		{
+			std::lock_guard<std::mutex> lock(m_state_mutex_);
+			m_stop_ = true;
+		}
+		m_wake_.notify_one();
+		m_thread_.join();
+	}
+
+	bool is_open() const { return m_file_.is_open(); }
+
+	//! @brief stage the bytes for writing; returns false if they were dropped
+	bool write(std::string_view bytes)
+	{
+		if (!m_thread_.joinable())
+			return false;
+		if (bytes.empty())
+			return true;
+
+		auto & ring = local_ring();
+		if (bytes.size() > ring.capacity())
+			return write_oversized(bytes);
+
+		m_queued_.fetch_add(bytes.size(), std::memory_order_relaxed); // before the push so the flusher never underflows it
+		while (!ring.try_push(bytes))
+		{
+			if (m_options_.overflow == async_log_overflow::drop)
+			{
+				m_queued_.fetch_sub(bytes.size(), std::memory_order_relaxed);
+				return count_dropped(bytes.size());
+			}
+			wait_for_room(ring, bytes.size());
+		}
+		if (ring.size() > ring.capacity() / 2)
+			request_drain();
+		return true;
+	}
+
+	//! @brief format with std::format on the calling thread and stage the result
+	template <class... Args> bool write_fmt(std::format_string<Args...> fmt, Args &&... args)
+	{
+		thread_local std::string buffer;
+		buffer.clear();
+		std::format_to(std::back_inserter(buffer), fmt, std::forward<Args>(args)...);
+		return write(buffer);
+	}
+
+	//! @brief block until every byte staged before the call has been written and flushed to the OS
+	void flush() { wait_ticket(false); }
+
+	//! @brief like flush() and also fsync the file
+	void sync() { wait_ticket(true); }
+
+	async_log_stats stats() const
+	{
+		async_log_stats ret;
+		ret.queued_bytes = m_queued_.load(std::memory_order_relaxed);
+		ret.written_bytes = m_written_.load(std::memory_order_relaxed);
+		ret.dropped_bytes = m_dropped_bytes_.load(std::memory_order_relaxed);
+		ret.dropped_messages = m_dropped_messages_.load(std::memory_order_relaxed);
+		return ret;
+	}
+
+private:
+	static std::uint64_t next_id()
+	{
+		static std::atomic<std::uint64_t> counter{0};
+		return ++counter;
+	}
+
+	details::async_log_ring & local_ring()
+	{
+		auto & cache = details::async_log_thread_cache::local();
+		for (const auto & e : cache.entries)
+		{
+			if (e.owner == m_id_)
+				return *e.ring;
+		}
+
+		// ids are never reused, so entries of destroyed loggers can be pruned safely
+		std::erase_if(cache.entries, [](const auto & e) { return e.weak.expired(); });
+		auto ring = std::make_shared<details::async_log_ring>(m_options_.thread_buffer_size);
+		{
+			std::lock_guard<std::mutex> lock(m_rings_mutex_);
+			m_rings_.push_back(ring);
+		}
+		cache.entries.push_back({m_id_, ring.get(), ring});
+		return *ring;
+	}
+
+	bool write_oversized(std::string_view bytes)
+	{
+		// a message that can never fit the ring would need a synchronous disk write: only block may stall the caller
+		if (m_options_.overflow == async_log_overflow::drop)
+			return count_dropped(bytes.size());
+		// keep this thread ordering: an empty ring only means the flusher drained it, possibly into a batch it has not
+		// written yet, so wait for a flush ticket (which covers every byte staged before it) and then write directly
+		wait_ticket(false);
+		std::lock_guard<std::mutex> lock(m_file_mutex_);
+		m_written_.fetch_add(m_file_.string_write(bytes), std::memory_order_relaxed);
+		return true;
+	}
+
+	bool count_dropped(std::size_t n)
+	{
+		m_dropped_bytes_.fetch_add(n, std::memory_order_relaxed);
+		m_dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	void request_drain()
+	{
+		// already pending: whoever set it notified under the mutex, so the flusher cannot miss it
+		if (m_urgent_.load(std::memory_order_acquire))
+			return;
+		{
+			std::lock_guard<std::mutex> lock(m_state_mutex_);
+			m_urgent_.store(true, std::memory_order_relaxed);
+		}
+		m_wake_.notify_one();
+	}
+
+	//! @brief block-policy producers sleep until a drain pass completes or the ring has room again
+	void wait_for_room(const details::async_log_ring & ring, std::size_t n)
+	{
+		std::unique_lock<std::mutex> lock(m_state_mutex_);
+		const auto pass = m_drain_passes_;
+		m_urgent_.store(true, std::memory_order_relaxed);
+		m_wake_.notify_one();
+		m_done_.wait(lock, [&] { return m_drain_passes_ != pass || ring.capacity() - ring.size() >= n; });
+	}
+
+	void wait_ticket(bool durable)
+	{
+		if (!m_thread_.joinable())
+			return;
+		std::unique_lock<std::mutex> lock(m_state_mutex_);
+		const auto ticket = ++m_requested_;
+		if (durable)
+			m_sync_requested_ = true;
+		m_wake_.notify_one();
+		m_done_.wait(lock, [&] { return m_completed_ >= ticket; });
+	}
+
+	std::size_t drain(std::string & batch)
+	{
+		std::size_t n = 0;
+		std::lock_guard<std::mutex> lock(m_rings_mutex_);
+		for (const auto & ring : m_rings_)
+			n += ring->drain_into(batch);
+		// rings of exited threads are final once orphaned, drop them after their last drain
+		std::erase_if(m_rings_, [](const auto & ring) { return ring->orphaned.load(std::memory_order_acquire) && ring->size() == 0; });
+		return n;
+	}
+
+	void run()
+	{
+		std::string batch;
+		auto last_sync = std::chrono::steady_clock::now();
+		std::unique_lock<std::mutex> lock(m_state_mutex_);
+		for (;;)
+		{
+			m_wake_.wait_for(lock, m_options_.flush_interval, [this] {
+				return m_stop_ || m_requested_ != m_completed_ || m_urgent_.load(std::memory_order_acquire);
+			});
+			m_urgent_.store(false, std::memory_order_relaxed);
+			const bool stopping = m_stop_;
+			const auto ticket = m_requested_;
+			const bool sync_requested = std::exchange(m_sync_requested_, false);
+			lock.unlock();
+
+			batch.clear();
+			if (const auto n = drain(batch); n != 0)
+			{
+				std::lock_guard<std::mutex> file_lock(m_file_mutex_);
+				m_written_.fetch_add(m_file_.string_write(batch), std::memory_order_relaxed);
+				m_file_.flush();
+				m_queued_.fetch_sub(n, std::memory_order_relaxed);
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			const bool sync_due = m_options_.sync_interval.count() > 0 && now - last_sync >= m_options_.sync_interval;
+			if (sync_requested || sync_due || (stopping && m_options_.sync_interval.count() > 0))
+			{
+				std::lock_guard<std::mutex> file_lock(m_file_mutex_);
+				m_file_.sync();
+				last_sync = now;
+			}
+
+			lock.lock();
+			++m_drain_passes_;
+			m_completed_ = ticket;
+			m_done_.notify_all();
+			if (stopping)
+				break;
+		}
+	}
+
+	file_ptr m_file_;
+	async_log_options m_options_;
+	const std::uint64_t m_id_{next_id()};
+
+	std::mutex m_rings_mutex_; // guards m_rings_ (registration and draining only)
+	std::vector<std::shared_ptr<details::async_log_ring>> m_rings_;
+	std::mutex m_file_mutex_; // serializes flusher writes with oversized direct writes
+
+	std::mutex m_state_mutex_;
+	std::condition_variable m_wake_;
+	std::condition_variable m_done_;
+	std::uint64_t m_requested_{0};
+	std::uint64_t m_completed_{0};
+	std::uint64_t m_drain_passes_{0}; // bumped after every flusher pass, wakes block-policy producers
+	bool m_sync_requested_{false};
+	bool m_stop_{false};
+	std::atomic<bool> m_urgent_{false}; // only set or cleared under m_state_mutex_, read lock-free by request_drain
+
+	std::atomic<std::uint64_t> m_queued_{0};
+	std::atomic<std::uint64_t> m_written_{0};
+	std::atomic<std::uint64_t> m_dropped_bytes_{0};
+	std::atomic<std::uint64_t> m_dropped_messages_{0};
+
+	std::thread m_thread_;
+}; // async_log_file
+
+} // namespace msl
+#endif // MSL_ASYNC_LOG_H__
@@ -0,0 +1,271 @@
+#ifndef MSL_ATOMIC_WRITER_H__
+#define MSL_ATOMIC_WRITER_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace msl
+{
+
+namespace details
+{
+//! @brief unique sibling of path: "<path>.<pid>.<counter>.tmp"
+inline std::string atomic_temp_path(const std::string & path)
+{
+	static std::atomic<std::uint64_t> counter{0};
+	#ifdef _WIN32
+	const auto pid = static_cast<std::uint64_t>(_getpid());
+	#else
+	const auto pid = static_cast<std::uint64_t>(::getpid());
+	#endif
+	return path + '.' + std::to_string(pid) + '.' + std::to_string(counter.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+}
+
+inline std::string parent_directory(const std::string & path)
+{
+	auto parent = std::filesystem::path(path).parent_path().string();
+	return parent.empty() ? std::string(".") : parent;
+}
+
+//! @brief persist a directory entry (renames inside it); a no-op on Windows where metadata is journaled
+inline std::error_code sync_directory(const std::string & directory)
+{
+	#ifdef _WIN32
+	(void)directory;
+	return {};
+	#else
+	const int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return {errno, std::generic_category()};
+	std::error_code ec;
+	if (::fsync(fd) != 0 && errno != EINVAL) // some filesystems refuse fsync on directories
+		ec = {errno, std::generic_category()};
+	::close(fd);
+	return ec;
+	#endif
+}
+
+//! @brief give the temporary file the permission bits of an existing destination, so a 0600 file stays 0600
+//! @note a missing destination keeps the umask-derived mode; a no-op on Windows
+inline std::error_code copy_target_mode([[maybe_unused]] const file_ptr & file, [[maybe_unused]] const std::string & path)
+{
+	#ifndef _WIN32
+	struct stat st;
+	if (::stat(path.c_str(), &st) != 0)
+		return errno == ENOENT ? std::error_code{} : std::error_code(errno, std::generic_category());
+	if (::fchmod(::fileno(file.get()), st.st_mode & 07777) != 0)
+		return {errno, std::generic_category()};
+	#endif
+	return {};
+}
+
+//! @brief start writeback without waiting so that later fsyncs of several files overlap
+inline void start_writeback([[maybe_unused]] const file_ptr & file)
+{
+	#if defined(__linux__) && defined(SYNC_FILE_RANGE_WRITE)
+	::sync_file_range(::fileno(file.get()), 0, 0, SYNC_FILE_RANGE_WRITE);
+	#endif
+}
+} // namespace details
+
+//! @brief writes into a temporary sibling of path and publishes it with a rename on commit()
+//! @note readers see either the old file or the complete new one; without commit() the temporary file is removed
+class atomic_writer
+{
+public:
+	explicit atomic_writer(const std::string_view & path, const std::string_view & mode = "wb") :
+		m_path_(path), m_temp_path_(details::atomic_temp_path(m_path_))
+	{
+		errno = 0;
+		m_file_.open(m_temp_path_, mode);
+		if (!m_file_)
+			m_error_ = errno != 0 ? std::error_code(errno, std::generic_category()) : std::make_error_code(std::errc::io_error);
+	}
+
+	atomic_writer(const atomic_writer &) = delete;
+	atomic_writer & operator=(const atomic_writer &) = delete;
+	~atomic_writer() { abort(); }
+
+	//! @brief the temporary file to write into
+	file_ptr & file() { return m_file_; }
+	const file_ptr & file() const { return m_file_; }
+
+	const std::string & path() const { return m_path_; }
+	const std::string & temp_path() const { return m_temp_path_; }
+	bool is_open() const { return static_cast<bool>(m_file_); }
+	explicit operator bool() const { return is_open() && !m_error_; }
+	std::error_code error() const { return m_error_; }
+
+	//! @brief flush, optionally fsync, then rename over path (and fsync the directory when durable)
+	//! @note an existing destination's permission bits are applied to the new file before the rename
+	std::error_code commit(bool durable = true)
+	{
+		if (auto ec = finish_file(durable))
+			return ec;
+		if (auto ec = publish())
+			return ec;
+		return durable ? details::sync_directory(details::parent_directory(m_path_)) : std::error_code{};
+	}
+
+	//! @brief drop the pending contents and remove the temporary file
+	void abort()
+	{
+		if (m_committed_ || m_temp_path_.empty())
+			return;
+		m_file_.close();
+		std::remove(m_temp_path_.c_str());
+		m_committed_ = true;
+	}
+
+private:
+	friend class atomic_commit_group;
+
+	//! @brief copy the destination's mode, flush (and fsync) the temporary file, then close it
+	std::error_code finish_file(bool durable)
+	{
+		if (m_committed_)
+			return m_error_ ? m_error_ : std::make_error_code(std::errc::operation_not_permitted);
+		if (!m_error_)
+			m_error_ = details::copy_target_mode(m_file_, m_path_);
+		if (!m_error_)
+		{
+			errno = 0;
+			m_file_.flush();
+			if (m_file_.error() || (durable && !m_file_.sync()))
+				m_error_ = errno != 0 ? std::error_code(errno, std::generic_category()) : std::make_error_code(std::errc::io_error);
+		}
+		if (m_error_)
+		{
+			abort();
+			return m_error_;
+		}
+		m_file_.close();
+		return {};
+	}
+
+	//! @brief rename the closed temporary file over the destination
+	std::error_code publish()
+	{
+		std::error_code ec;
+		std::filesystem::rename(m_temp_path_, m_path_, ec);
+		if (ec)
+		{
+			m_error_ = ec;
+			abort();
+			return ec;
+		}
+		m_committed_ = true;
+		return {};
+	}
+
+	std::string m_path_;
+	std::string m_temp_path_;
+	file_ptr m_file_;
+	std::error_code m_error_;
+	bool m_committed_{false};
+}; // atomic_writer
+
+//! @brief batches atomic_writers into one group commit: fsync every file, rename them, fsync each directory once
+class atomic_commit_group
+{
+public:
+	//! @brief start a pending save; write into the returned writer and leave publishing to commit()
+	atomic_writer & add(const std::string_view & path, const std::string_view & mode = "wb")
+	{
+		m_writers_.push_back(std::make_unique<atomic_writer>(path, mode));
+		return *m_writers_.back();
+	}
+
+	std::size_t size() const { return m_writers_.size(); }
+	bool empty() const { return m_writers_.empty(); }
+
+	//! @brief publish every pending writer; failed ones are rolled back and the first error is returned
+	//! @note the group is empty afterwards either way
+	std::error_code commit(bool durable = true)
+	{
+		std::error_code first_error;
+		const auto note = [&](const std::error_code & ec) {
+			if (ec && !first_error)
+				first_error = ec;
+		};
+
+		if (durable)
+		{
+			for (auto & writer : m_writers_)
+			{
+				if (*writer)
+				{
+					writer->m_file_.flush();
+					details::start_writeback(writer->m_file_);
+				}
+			}
+		}
+
+		std::unordered_set<std::string> directories;
+		for (auto & writer : m_writers_)
+		{
+			if (const auto ec = writer->finish_file(durable))
+			{
+				note(ec);
+				continue;
+			}
+			if (const auto ec = writer->publish())
+			{
+				note(ec);
+				continue;
+			}
+			if (durable)
+				directories.insert(details::parent_directory(writer->path()));
+		}
+		for (const auto & directory : directories)
+			note(details::sync_directory(directory));
+
+		m_writers_.clear();
+		return first_error;
+	}
+
+	//! @brief discard every pending writer
+	void abort() { m_writers_.clear(); }
+
+private:
+	std::vector<std::unique_ptr<atomic_writer>> m_writers_;
+}; // atomic_commit_group
+
+} // namespace msl
+#endif // MSL_ATOMIC_WRITER_H__
@@ -0,0 +1,464 @@
+#ifndef MSL_COMPRESS_H__
+#define MSL_COMPRESS_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+#include "hash.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace msl
+{
+
+namespace details
+{
+inline constexpr std::size_t block_min_match = 4;
+inline constexpr std::size_t block_last_literals = 5; // the format always ends with literals
+inline constexpr std::size_t block_match_safety = 12; // no match may start in the last 12 bytes
+inline constexpr std::size_t block_max_offset = 65535;
+inline constexpr int block_hash_bits = 14;
+
+inline std::uint32_t block_read32(const unsigned char * p) noexcept
+{
+	std::uint32_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+inline std::uint32_t block_hash(std::uint32_t sequence) noexcept
+{
+	return (sequence * 2654435761u) >> (32 - block_hash_bits);
+}
+
+//! @brief write an LZ4 length continuation (255-runs plus remainder); false if out of room
+inline bool block_put_length(unsigned char *& op, const unsigned char * oend, std::size_t length) noexcept
+{
+	for (; length >= 255; length -= 255)
+	{
+		if (op == oend)
+			return false;
+		*op++ = 255;
+	}
+	if (op == oend)
+		return false;
+	*op++ = static_cast<unsigned char>(length);
+	return true;
+}
+
+//! @brief emit one sequence: literals [anchor, anchor + literals) then an optional match
+inline bool block_put_sequence(unsigned char *& op, const unsigned char * oend, const unsigned char * anchor, std::size_t literals,
+	std::size_t offset, std::size_t match_length) noexcept
+{
+	if (op == oend)
+		return false;
+	unsigned char * const token = op++;
+	*token = static_cast<unsigned char>((std::min)(literals, std::size_t{15}) << 4);
+	if (literals >= 15 && !block_put_length(op, oend, literals - 15))
+		return false;
+	if (static_cast<std::size_t>(oend - op) < literals)
+		return false;
+	if (literals != 0)
+		std::memcpy(op, anchor, literals);
+	op += literals;
+	if (match_length == 0)
+		return true;
+
+	if (oend - op < 2)
+		return false;
+	*op++ = static_cast<unsigned char>(offset & 0xFF);
+	*op++ = static_cast<unsigned char>(offset >> 8);
+	const auto extra = match_length - block_min_match;
+	*token |= static_cast<unsigned char>((std::min)(extra, std::size_t{15}));
+	return extra < 15 || block_put_length(op, oend, extra - 15);
+}
+} // namespace details
+
+//! @brief worst-case compressed size of n bytes
+constexpr std::size_t block_compress_bound(std::size_t n) noexcept
+{
+	return n + n / 255 + 16;
+}
+
+//! @brief block_compress encodes src in the LZ4 block format (greedy single-probe matcher)
+//! @return compressed size, or 0 if dst is too small (block_compress_bound always suffices)
+inline std::size_t block_compress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept
+{
+	const auto base = reinterpret_cast<const unsigned char *>(src.data());
+	const auto end = base + src.size();
+	auto op = reinterpret_cast<unsigned char *>(dst.data());
+	const auto out = op;
+	const auto oend = op + dst.size();
+	const unsigned char * anchor = base;
+
+	if (src.size() > details::block_match_safety)
+	{
+		std::array<std::uint32_t, std::size_t{1} << details::block_hash_bits> table{};
+		const auto match_limit = end - details::block_last_literals;
+		const auto scan_limit = end - details::block_match_safety;
+		const unsigned char * ip = base + 1;
+		while (ip < scan_limit)
+		{
+			const auto sequence = details::block_read32(ip);
+			auto & slot = table[details::block_hash(sequence)];
+			const unsigned char * ref = base + slot;
+			slot = static_cast<std::uint32_t>(ip - base);
+			if (ref >= ip || static_cast<std::size_t>(ip - ref) > details::block_max_offset || details::block_read32(ref) != sequence)
+			{
+				ip += 1 + (static_cast<std::size_t>(ip - anchor) >> 6); // skip faster through incompressible data
+				continue;
+			}
+
+			while (ip > anchor && ref > base && ip[-1] == ref[-1])
+			{
+				--ip;
+				--ref;
+			}
+			auto length = details::block_min_match;
+			while (ip + length < match_limit && ip[length] == ref[length])
+				++length;
+
+			if (!details::block_put_sequence(op, oend, anchor, static_cast<std::size_t>(ip - anchor), static_cast<std::size_t>(ip - ref), length))
+				return 0;
+			ip += length;
+			anchor = ip;
+			if (ip < scan_limit)
+				table[details::block_hash(details::block_read32(ip - 2))] = static_cast<std::uint32_t>(ip - 2 - base);
+		}
+	}
+
+	if (!details::block_put_sequence(op, oend, anchor, static_cast<std::size_t>(end - anchor), 0, 0))
+		return 0;
+	return static_cast<std::size_t>(op - out);
+}
+
+//! @brief block_decompress decodes an LZ4 block into dst, validating every length and offset
+//! @return decoded size, or nullopt if src is malformed or does not fit dst
+inline std::optional<std::size_t> block_decompress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept
+{
+	auto ip = reinterpret_cast<const unsigned char *>(src.data());
+	const auto iend = ip + src.size();
+	auto op = reinterpret_cast<unsigned char *>(dst.data());
+	const auto out = op;
+	const auto oend = op + dst.size();
+
+	const auto get_length = [&](std::size_t & length) {
+		unsigned char b;
+		do
+		{
+			if (ip == iend)
+				return false;
+			b = *ip++;
+			length += b;
+		} while (b == 255);
+		return true;
+	};
+
+	while (ip < iend)
+	{
+		const auto token = *ip++;
+		std::size_t literals = token >> 4;
+		if (literals == 15 && !get_length(literals))
+			return std::nullopt;
+		if (literals > static_cast<std::size_t>(iend - ip) || literals > static_cast<std::size_t>(oend - op))
+			return std::nullopt;
+		if (literals != 0)
+			std::memcpy(op, ip, literals);
+		ip += literals;
+		op += literals;
+		if (ip == iend)
+			break; // last sequence carries literals only
+
+		if (iend - ip < 2)
+			return std::nullopt;
+		const std::size_t offset = ip[0] | (std::size_t{ip[1]} << 8);
+		ip += 2;
+		if (offset == 0 || offset > static_cast<std::size_t>(op - out))
+			return std::nullopt;
+		std::size_t length = token & 15;
+		if (length == 15 && !get_length(length))
+			return std::nullopt;
+		length += details::block_min_match;
+		if (length > static_cast<std::size_t>(oend - op))
+			return std::nullopt;
+
+		const unsigned char * match = op - offset;
+		if (offset >= 8 && static_cast<std::size_t>(oend - op) >= length + 8)
+		{
+			// 8-byte strides may run up to 7 bytes past the match, still inside dst
+			for (std::size_t i = 0; i < length; i += 8)
+				std::memcpy(op + i, match + i, 8);
+		}
+		else
+		{
+			for (std::size_t i = 0; i < length; ++i)
+				op[i] = match[i];
+		}
+		op += length;
+	}
+	return static_cast<std::size_t>(op - out);
+}
+
+namespace details
+{
+inline constexpr std::array<char, 4> compressed_magic{'M', 'S', 'L', 'Z'};
+inline constexpr std::uint32_t compressed_version = 1;
+inline constexpr std::uint32_t compressed_stored_flag = 0x80000000u; // block kept raw (did not shrink)
+inline constexpr std::uint32_t compressed_max_block = 64u << 20;
+} // namespace details
+
+struct compressed_options
+{
+	std::size_t block_size{256 << 10}; // uncompressed bytes per framed block
+};
+
+//! @brief framed block compression into a file_ptr
+//! @note frame: "MSLZ", version, block size; blocks: raw size, stored size (+ raw flag), CRC-32C of the raw bytes; a zero raw size ends it
+class compressed_writer
+{
+public:
+	explicit compressed_writer(file_ptr file, compressed_options options = {}) : m_file_(std::move(file))
+	{
+		m_block_size_ = std::clamp<std::size_t>(options.block_size, 1, details::compressed_max_block);
+		if (!m_file_)
+		{
+			m_error_ = std::make_error_code(std::errc::bad_file_descriptor);
+			return;
+		}
+		m_buffer_.reserve(m_block_size_);
+		m_output_.resize(block_compress_bound(m_block_size_));
+		const bool ok = m_file_.write(static_cast<const void *>(details::compressed_magic.data()), details::compressed_magic.size()) == details::compressed_magic.size() &&
+			m_file_.write<std::endian::little>(details::compressed_version) &&
+			m_file_.write<std::endian::little>(static_cast<std::uint32_t>(m_block_size_));
+		if (!ok)
+			m_error_ = std::make_error_code(std::errc::io_error);
+	}
+	explicit compressed_writer(const std::string_view & filename, compressed_options options = {}) :
+		compressed_writer(file_ptr(filename, "wb"), options)
+	{
+	}
+
+	compressed_writer(const compressed_writer &) = delete;
+	compressed_writer & operator=(const compressed_writer &) = delete;
+	~compressed_writer() { finish(); }
+
+	//! @brief buffer data, compressing every full block
+	bool write(std::span<const std::byte> data)
+	{
+		if (m_finished_ || m_error_)
+			return false;
+		while (!data.empty())
+		{
+			const auto take = (std::min)(data.size(), m_block_size_ - m_buffer_.size());
+			m_buffer_.insert(m_buffer_.end(), data.begin(), data.begin() + static_cast<std::ptrdiff_t>(take));
+			data = data.subspan(take);
+			if (m_buffer_.size() == m_block_size_ && !flush_block())
+				return false;
+		}
+		return true;
+	}
+	bool write(const void * data, std::size_t size) { return write(std::span<const std::byte>(static_cast<const std::byte *>(data), size)); }
+	bool string_write(std::string_view str) { return write(std::as_bytes(std::span(str))); }
+
+	//! @brief compress the pending block, write the end marker and flush the file; further writes fail
+	bool finish()
+	{
+		if (m_finished_)
+			return !m_error_;
+		m_finished_ = true;
+		if (m_error_ || !flush_block())
+			return false;
+		if (!m_file_.write<std::endian::little>(std::uint32_t{0}))
+			m_error_ = std::make_error_code(std::errc::io_error);
+		m_file_.flush();
+		return !m_error_;
+	}
+
+	std::error_code error() const { return m_error_; }
+	//! @brief uncompressed bytes accepted so far
+	std::uint64_t bytes_in() const { return m_bytes_in_; }
+	//! @brief framed bytes written so far (excluding the pending block)
+	std::uint64_t bytes_out() const { return m_bytes_out_; }
+
+private:
+	bool flush_block()
+	{
+		if (m_buffer_.empty())
+			return true;
+		const auto raw = std::span<const std::byte>(m_buffer_);
+		auto size = block_compress(raw, m_output_);
+		auto stored = static_cast<std::uint32_t>(size);
+		std::span<const std::byte> payload(m_output_.data(), size);
+		if (size == 0 || size >= raw.size())
+		{
+			stored = static_cast<std::uint32_t>(raw.size()) | details::compressed_stored_flag;
+			payload = raw;
+		}
+		const bool ok = m_file_.write<std::endian::little>(static_cast<std::uint32_t>(raw.size())) && m_file_.write<std::endian::little>(stored) &&
+			m_file_.write<std::endian::little>(crc32c::hash(raw)) &&
+			m_file_.write(static_cast<const void *>(payload.data()), payload.size()) == payload.size();
+		if (!ok)
+		{
+			m_error_ = std::make_error_code(std::errc::io_error);
+			return false;
+		}
+		m_bytes_in_ += raw.size();
+		m_bytes_out_ += 12 + payload.size();
+		m_buffer_.clear();
+		return true;
+	}
+
+	file_ptr m_file_;
+	std::size_t m_block_size_{0};
+	std::vector<std::byte> m_buffer_;
+	std::vector<std::byte> m_output_;
+	std::uint64_t m_bytes_in_{0};
+	std::uint64_t m_bytes_out_{0};
+	bool m_finished_{false};
+	std::error_code m_error_;
+}; // compressed_writer
+
+//! @brief reads a compressed_writer frame back, verifying each block checksum
+class compressed_reader
+{
+public:
+	explicit compressed_reader(file_ptr file) : m_file_(std::move(file))
+	{
+		if (!m_file_)
+		{
+			m_error_ = std::make_error_code(std::errc::bad_file_descriptor);
+			return;
+		}
+		std::array<char, 4> magic{};
+		const auto version = (m_file_.fread(magic.data(), magic.size()) == magic.size()) ? m_file_.read<std::uint32_t, std::endian::little>() : std::nullopt;
+		const auto block_size = m_file_.read<std::uint32_t, std::endian::little>();
+		if (magic != details::compressed_magic || version != details::compressed_version || !block_size || *block_size == 0 ||
+			*block_size > details::compressed_max_block)
+		{
+			m_error_ = std::make_error_code(std::errc::illegal_byte_sequence);
+			return;
+		}
+		m_block_size_ = *block_size;
+	}
+	explicit compressed_reader(const std::string_view & filename) : compressed_reader(file_ptr(filename, "rb")) {}
+
+	//! @brief read up to n uncompressed bytes; fewer at the end of the frame or on error
+	std::size_t read(void * data, std::size_t n)
+	{
+		auto out = static_cast<std::byte *>(data);
+		std::size_t done = 0;
+		while (done < n)
+		{
+			if (m_pos_ == m_block_.size() && !next_block())
+				break;
+			const auto take = (std::min)(n - done, m_block_.size() - m_pos_);
+			std::memcpy(out + done, m_block_.data() + m_pos_, take);
+			m_pos_ += take;
+			done += take;
+		}
+		return done;
+	}
+	template <typename T> std::size_t read(std::span<T> buffer) { return read(buffer.data(), buffer.size_bytes()) / sizeof(T); }
+
+	//! @brief decompress everything that is left
+	std::vector<char> read_all()
+	{
+		std::vector<char> ret;
+		while (m_pos_ < m_block_.size() || next_block())
+		{
+			const auto * first = reinterpret_cast<const char *>(m_block_.data() + m_pos_);
+			ret.insert(ret.end(), first, first + (m_block_.size() - m_pos_));
+			m_pos_ = m_block_.size();
+		}
+		return ret;
+	}
+
+	//! @brief true once the end marker was reached and every byte was consumed
+	bool eof() const { return m_end_ && m_pos_ == m_block_.size(); }
+	//! @brief illegal_byte_sequence on a bad frame or checksum, io_error on a truncated file
+	std::error_code error() const { return m_error_; }
+
+private:
+	bool next_block()
+	{
+		m_block_.clear();
+		m_pos_ = 0;
+		if (m_end_ || m_error_)
+			return false;
+		const auto raw_size = m_file_.read<std::uint32_t, std::endian::little>();
+		if (raw_size == 0u)
+		{
+			m_end_ = true;
+			return false;
+		}
+		const auto stored = m_file_.read<std::uint32_t, std::endian::little>();
+		const auto checksum = m_file_.read<std::uint32_t, std::endian::little>();
+		if (!raw_size || !stored || !checksum)
+			return fail(std::errc::io_error);
+		const bool raw = (*stored & details::compressed_stored_flag) != 0;
+		const auto stored_size = *stored & ~details::compressed_stored_flag;
+		if (*raw_size > m_block_size_ || stored_size > block_compress_bound(m_block_size_) || (raw && stored_size != *raw_size))
+			return fail(std::errc::illegal_byte_sequence);
+
+		m_block_.resize(*raw_size);
+		if (raw)
+		{
+			if (m_file_.fread(m_block_.data(), stored_size) != stored_size)
+				return fail(std::errc::io_error);
+		}
+		else
+		{
+			m_input_.resize(stored_size);
+			if (m_file_.fread(m_input_.data(), stored_size) != stored_size)
+				return fail(std::errc::io_error);
+			if (block_decompress(m_input_, m_block_) != std::optional<std::size_t>(*raw_size))
+				return fail(std::errc::illegal_byte_sequence);
+		}
+		if (crc32c::hash(m_block_) != *checksum)
+			return fail(std::errc::illegal_byte_sequence);
+		return true;
+	}
+
+	bool fail(std::errc code)
+	{
+		m_error_ = std::make_error_code(code);
+		m_block_.clear();
+		return false;
+	}
+
+	file_ptr m_file_;
+	std::uint32_t m_block_size_{0};
+	std::vector<std::byte> m_block_;
+	std::vector<std::byte> m_input_;
+	std::size_t m_pos_{0};
+	bool m_end_{false};
+	std::error_code m_error_;
+}; // compressed_reader
+
+} // namespace msl
+#endif // MSL_COMPRESS_H__
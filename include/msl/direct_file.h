@@ -0,0 +1,339 @@
+#ifndef MSL_DIRECT_FILE_H__
+#define MSL_DIRECT_FILE_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace msl
+{
+
+enum class direct_mode
+{
+	read,
+	write, // create or truncate
+};
+
+struct direct_options
+{
+	std::size_t alignment{4096}; // buffer, offset and length alignment required by the device (power of two)
+	std::size_t buffer_size{1 << 20}; // staging buffer, rounded up to the alignment
+};
+
+namespace details
+{
+struct aligned_deleter
+{
+	std::size_t alignment;
+	void operator()(std::byte * p) const { ::operator delete(p, std::align_val_t{alignment}); }
+};
+using aligned_buffer = std::unique_ptr<std::byte[], aligned_deleter>;
+
+inline aligned_buffer make_aligned_buffer(std::size_t size, std::size_t alignment)
+{
+	return aligned_buffer(static_cast<std::byte *>(::operator new(size, std::align_val_t{alignment})), aligned_deleter{alignment});
+}
+
+inline bool is_aligned(const void * p, std::size_t alignment)
+{
+	return (reinterpret_cast<std::uintptr_t>(p) & (alignment - 1)) == 0;
+}
+
+//! @brief positional full-length transfer; returns bytes moved (short only at EOF or on error)
+//! @note error is set when the transfer stopped on a failed call rather than at EOF;
+//! with direct set a short call ends the transfer, as retrying at the unaligned offset would fail with EINVAL
+template <bool Write>
+std::size_t direct_transfer(int fd, std::byte * data, std::size_t size, std::uint64_t offset, bool direct, std::error_code & error)
+{
+	std::size_t done = 0;
+	while (done < size)
+	{
+		#ifdef _WIN32
+		if (_lseeki64(fd, static_cast<__int64>(offset + done), SEEK_SET) < 0)
+		{
+			error = {errno, std::generic_category()};
+			break;
+		}
+		const auto chunk = static_cast<unsigned>((std::min)(size - done, std::size_t{1} << 30));
+		const int n = Write ? _write(fd, data + done, chunk) : _read(fd, data + done, chunk);
+		#else
+		const auto n = Write ? ::pwrite(fd, data + done, size - done, static_cast<off_t>(offset + done))
+							 : ::pread(fd, data + done, size - done, static_cast<off_t>(offset + done));
+		if (n < 0 && errno == EINTR)
+			continue;
+		#endif
+		if (n < 0)
+			error = {errno, std::generic_category()};
+		if (n <= 0)
+			break;
+		done += static_cast<std::size_t>(n);
+		if (direct && done < size)
+			break;
+	}
+	return done;
+}
+} // namespace details
+
+//! @brief unbuffered sequential file I/O that bypasses the page cache (O_DIRECT, F_NOCACHE on macOS)
+//! @note stages data in an aligned buffer and pads plus truncates the unaligned tail on close;
+//! falls back to regular I/O (is_direct() == false) where the filesystem or platform refuses direct I/O
+class direct_file
+{
+public:
+	direct_file() = default;
+	direct_file(const std::string_view & path, direct_mode mode, direct_options options = {}) { open(path, mode, options); }
+
+	direct_file(const direct_file &) = delete;
+	direct_file & operator=(const direct_file &) = delete;
+	direct_file(direct_file && other) noexcept { *this = std::move(other); }
+	direct_file & operator=(direct_file && other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			m_fd_ = std::exchange(other.m_fd_, -1);
+			m_mode_ = other.m_mode_;
+			m_direct_ = other.m_direct_;
+			m_alignment_ = other.m_alignment_;
+			m_capacity_ = other.m_capacity_;
+			m_buffer_ = std::move(other.m_buffer_);
+			m_used_ = std::exchange(other.m_used_, 0);
+			m_pos_ = std::exchange(other.m_pos_, 0);
+			m_buffer_offset_ = std::exchange(other.m_buffer_offset_, 0);
+			m_file_offset_ = std::exchange(other.m_file_offset_, 0);
+			m_error_ = std::exchange(other.m_error_, {});
+		}
+		return *this;
+	}
+	~direct_file() { close(); }
+
+	//! @brief open path for direct I/O, closing any previous file; check error() on failure
+	bool open(const std::string_view & path, direct_mode mode, direct_options options = {})
+	{
+		close();
+		m_error_ = {};
+		m_mode_ = mode;
+		m_direct_ = false;
+		m_alignment_ = std::bit_ceil((std::max)(options.alignment, std::size_t{512}));
+		m_capacity_ = (std::max)((options.buffer_size + m_alignment_ - 1) & ~(m_alignment_ - 1), m_alignment_);
+
+		const std::string path_str(path);
+		#ifdef _WIN32
+		// FILE_FLAG_NO_BUFFERING needs CreateFile handles; the CRT descriptors used here stay buffered
+		const int flags = _O_BINARY | (mode == direct_mode::read ? _O_RDONLY : (_O_WRONLY | _O_CREAT | _O_TRUNC));
+		m_fd_ = _open(path_str.c_str(), flags, _S_IREAD | _S_IWRITE);
+		#else
+		const int flags = O_CLOEXEC | (mode == direct_mode::read ? O_RDONLY : (O_WRONLY | O_CREAT | O_TRUNC));
+		#ifdef O_DIRECT
+		m_fd_ = ::open(path_str.c_str(), flags | O_DIRECT, 0644);
+		m_direct_ = m_fd_ >= 0;
+		if (m_fd_ < 0 && errno == EINVAL) // filesystem without direct I/O (tmpfs and alike)
+			m_fd_ = ::open(path_str.c_str(), flags, 0644);
+		#else
+		m_fd_ = ::open(path_str.c_str(), flags, 0644);
+		#if defined(F_NOCACHE)
+		m_direct_ = m_fd_ >= 0 && ::fcntl(m_fd_, F_NOCACHE, 1) == 0;
+		#endif
+		#endif
+		#endif
+		if (m_fd_ < 0)
+		{
+			m_error_ = {errno, std::generic_category()};
+			return false;
+		}
+		m_buffer_ = details::make_aligned_buffer(m_capacity_, m_alignment_);
+		return true;
+	}
+
+	//! @brief flush the pending tail (padded to the alignment, then truncated back) and close
+	std::error_code close()
+	{
+		if (m_fd_ < 0)
+			return m_error_;
+		if (m_mode_ == direct_mode::write)
+			flush_tail();
+		#ifdef _WIN32
+		_close(m_fd_);
+		#else
+		::close(m_fd_);
+		#endif
+		m_fd_ = -1;
+		m_buffer_.reset();
+		m_used_ = m_pos_ = 0;
+		m_buffer_offset_ = m_file_offset_ = 0;
+		return m_error_;
+	}
+
+	bool is_open() const { return m_fd_ >= 0; }
+	explicit operator bool() const { return is_open() && !m_error_; }
+	//! @brief true if the page cache is really bypassed
+	bool is_direct() const { return m_direct_; }
+	std::size_t alignment() const { return m_alignment_; }
+	std::error_code error() const { return m_error_; }
+	//! @brief logical position: bytes written so far, or the next byte read() returns
+	std::uint64_t tell() const { return m_mode_ == direct_mode::write ? m_file_offset_ + m_used_ : m_buffer_offset_ + m_pos_; }
+
+	//! @brief append data; full aligned blocks go straight from an aligned span to the device
+	std::size_t write(std::span<const std::byte> data)
+	{
+		if (m_fd_ < 0 || m_mode_ != direct_mode::write || m_error_)
+			return 0;
+		std::size_t done = 0;
+		while (done < data.size())
+		{
+			const auto rest = data.subspan(done);
+			if (m_used_ == 0 && rest.size() >= m_alignment_ && details::is_aligned(rest.data(), m_alignment_))
+			{
+				const auto direct = rest.size() & ~(m_alignment_ - 1);
+				if (!write_at(const_cast<std::byte *>(rest.data()), direct))
+					return done;
+				done += direct;
+				continue;
+			}
+			const auto take = (std::min)(rest.size(), m_capacity_ - m_used_);
+			std::memcpy(m_buffer_.get() + m_used_, rest.data(), take);
+			m_used_ += take;
+			done += take;
+			if (m_used_ == m_capacity_)
+			{
+				if (!write_at(m_buffer_.get(), m_capacity_))
+					return done;
+				m_used_ = 0;
+			}
+		}
+		return done;
+	}
+	//! @brief typed span write; returns bytes written, like file_ptr::write(std::span<const T>)
+	template <typename T> std::size_t write(std::span<const T> values) { return write(std::as_bytes(values)); }
+
+	//! @brief read up to buffer.size() bytes; short only at EOF or on error
+	std::size_t read(std::span<std::byte> buffer)
+	{
+		if (m_fd_ < 0 || m_mode_ != direct_mode::read || m_error_)
+			return 0;
+		std::size_t done = 0;
+		while (done < buffer.size())
+		{
+			if (m_pos_ == m_used_ && (at_direct_eof() || !fill_at(m_buffer_offset_ + m_used_) || m_used_ == 0))
+				break;
+			const auto take = (std::min)(buffer.size() - done, m_used_ - m_pos_);
+			std::memcpy(buffer.data() + done, m_buffer_.get() + m_pos_, take);
+			m_pos_ += take;
+			done += take;
+		}
+		return done;
+	}
+	//! @brief typed span read; returns whole elements read, like file_ptr::read(std::span<T>)
+	template <typename T> std::size_t read(std::span<T> values) { return read(std::as_writable_bytes(values)) / sizeof(T); }
+
+	//! @brief move the read position (read mode only); false if the block there could not be read (see error())
+	bool seek(std::uint64_t offset)
+	{
+		if (m_fd_ < 0 || m_mode_ != direct_mode::read)
+			return false;
+		const auto aligned = offset & ~static_cast<std::uint64_t>(m_alignment_ - 1);
+		if (!fill_at(aligned))
+			return false;
+		m_pos_ = (std::min)(static_cast<std::size_t>(offset - aligned), m_used_);
+		return true;
+	}
+
+private:
+	//! @brief a direct buffer ending off a block boundary was cut short by EOF; reading past it would be unaligned
+	bool at_direct_eof() const { return m_direct_ && (m_used_ & (m_alignment_ - 1)) != 0; }
+
+	//! @brief load the block at offset into the buffer; a short block is EOF, a failed read sets error()
+	bool fill_at(std::uint64_t offset)
+	{
+		std::error_code ec;
+		m_buffer_offset_ = offset;
+		m_pos_ = 0;
+		m_used_ = details::direct_transfer<false>(m_fd_, m_buffer_.get(), m_capacity_, offset, m_direct_, ec);
+		if (ec)
+			m_error_ = ec;
+		return !ec;
+	}
+
+	bool write_at(std::byte * data, std::size_t size)
+	{
+		std::error_code ec;
+		if (details::direct_transfer<true>(m_fd_, data, size, m_file_offset_, m_direct_, ec) != size)
+		{
+			m_error_ = ec ? ec : std::make_error_code(std::errc::io_error);
+			return false;
+		}
+		m_file_offset_ += size;
+		return true;
+	}
+
+	void flush_tail()
+	{
+		if (m_used_ == 0 || m_error_)
+			return;
+		const auto logical = m_file_offset_ + m_used_;
+		const auto padded = (m_used_ + m_alignment_ - 1) & ~(m_alignment_ - 1);
+		std::memset(m_buffer_.get() + m_used_, 0, padded - m_used_);
+		if (!write_at(m_buffer_.get(), padded))
+			return;
+		#ifdef _WIN32
+		const bool truncated = _chsize_s(m_fd_, static_cast<__int64>(logical)) == 0;
+		#else
+		const bool truncated = ::ftruncate(m_fd_, static_cast<off_t>(logical)) == 0;
+		#endif
+		if (!truncated)
+			m_error_ = {errno, std::generic_category()};
+		m_file_offset_ = logical;
+		m_used_ = 0;
+	}
+
+	int m_fd_{-1};
+	direct_mode m_mode_{direct_mode::read};
+	bool m_direct_{false};
+	std::size_t m_alignment_{4096};
+	std::size_t m_capacity_{0};
+	details::aligned_buffer m_buffer_{nullptr, details::aligned_deleter{4096}};
+	std::size_t m_used_{0}; // write: staged bytes; read: valid bytes in the buffer
+	std::size_t m_pos_{0}; // read: consumed bytes in the buffer
+	std::uint64_t m_buffer_offset_{0}; // read: file offset of the buffer
+	std::uint64_t m_file_offset_{0}; // write: bytes already on the device
+	std::error_code m_error_;
+}; // direct_file
+
+} // namespace msl
+#endif // MSL_DIRECT_FILE_H__
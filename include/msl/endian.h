@@ -0,0 +1,112 @@
+#ifndef MSL_ENDIAN_H__
+#define MSL_ENDIAN_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+static_assert(std::endian::native == std::endian::little || std::endian::native == std::endian::big,
+	"msl/endian.h does not support mixed-endian platforms");
+
+namespace msl
+{
+
+namespace details
+{
+template <std::size_t N> struct uint_of_size;
+template <> struct uint_of_size<1> { using type = std::uint8_t; };
+template <> struct uint_of_size<2> { using type = std::uint16_t; };
+template <> struct uint_of_size<4> { using type = std::uint32_t; };
+template <> struct uint_of_size<8> { using type = std::uint64_t; };
+
+template <typename T>
+concept byte_swappable =
+	(std::is_arithmetic_v<T> || std::is_enum_v<T>) && requires { typename uint_of_size<sizeof(T)>::type; };
+} // namespace details
+
+//! @brief byteswap reverses the bytes of an integral value (std::byteswap backport)
+template <std::integral T> constexpr T byteswap(T value) noexcept
+{
+	if constexpr (sizeof(T) == 1)
+		return value;
+	#if defined(__GNUC__) || defined(__clang__)
+	else if constexpr (sizeof(T) == 2)
+		return static_cast<T>(__builtin_bswap16(static_cast<std::uint16_t>(value)));
+	else if constexpr (sizeof(T) == 4)
+		return static_cast<T>(__builtin_bswap32(static_cast<std::uint32_t>(value)));
+	else if constexpr (sizeof(T) == 8)
+		return static_cast<T>(__builtin_bswap64(static_cast<std::uint64_t>(value)));
+	#endif
+	else
+	{
+		auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+		std::ranges::reverse(bytes);
+		return std::bit_cast<T>(bytes);
+	}
+}
+
+//! @brief byteswap_value reverses the bytes of any arithmetic or enum value (floating point included)
+template <details::byte_swappable T> constexpr T byteswap_value(T value) noexcept
+{
+	using U = typename details::uint_of_size<sizeof(T)>::type;
+	return std::bit_cast<T>(byteswap(std::bit_cast<U>(value)));
+}
+
+//! @brief to_endian converts a native value into the E byte order
+template <std::endian E, typename T> constexpr T to_endian(T value) noexcept
+{
+	if constexpr (E == std::endian::native)
+		return value;
+	else
+		return byteswap_value(value);
+}
+
+//! @brief from_endian converts a value stored with the E byte order into the native one
+template <std::endian E, typename T> constexpr T from_endian(T value) noexcept
+{
+	return to_endian<E>(value); // a byte swap is its own inverse
+}
+
+//! @brief convert_endian_in_place swaps a whole array between native and E byte order
+//! @note the loop works on the unsigned representation so compilers turn it into vector shuffles
+template <std::endian E, details::byte_swappable T, std::size_t Extent>
+void convert_endian_in_place(std::span<T, Extent> values) noexcept
+{
+	if constexpr (E != std::endian::native && sizeof(T) > 1)
+	{
+		using U = typename details::uint_of_size<sizeof(T)>::type;
+		auto * bytes = reinterpret_cast<unsigned char *>(values.data());
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			U raw;
+			std::memcpy(&raw, bytes + i * sizeof(T), sizeof(T));
+			raw = byteswap(raw);
+			std::memcpy(bytes + i * sizeof(T), &raw, sizeof(T));
+		}
+	}
+}
+
+} // namespace msl
+#endif // MSL_ENDIAN_H__
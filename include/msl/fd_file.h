@@ -0,0 +1,460 @@
+#ifndef MSL_FD_FILE_H__
+#define MSL_FD_FILE_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "endian.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace msl
+{
+
+namespace details
+{
+//! @brief open(2) flags for an fopen-style mode ("r", "w+b", "ax", ...); -1 if the mode is invalid
+inline int fd_open_flags(std::string_view mode)
+{
+	#ifdef _WIN32
+	constexpr int rdonly = _O_RDONLY, wronly = _O_WRONLY, rdwr = _O_RDWR, creat = _O_CREAT, trunc = _O_TRUNC, append = _O_APPEND, excl = _O_EXCL;
+	constexpr int extra = _O_BINARY;
+	#else
+	constexpr int rdonly = O_RDONLY, wronly = O_WRONLY, rdwr = O_RDWR, creat = O_CREAT, trunc = O_TRUNC, append = O_APPEND, excl = O_EXCL;
+	constexpr int extra = O_CLOEXEC;
+	#endif
+	if (mode.empty())
+		return -1;
+	const bool plus = mode.find('+') != std::string_view::npos;
+	int flags = extra;
+	switch (mode.front())
+	{
+	case 'r':
+		flags |= plus ? rdwr : rdonly;
+		break;
+	case 'w':
+		flags |= (plus ? rdwr : wronly) | creat | trunc;
+		break;
+	case 'a':
+		flags |= (plus ? rdwr : wronly) | creat | append;
+		break;
+	default:
+		return -1;
+	}
+	if (mode.find('x') != std::string_view::npos)
+		flags |= excl;
+	return flags;
+}
+
+//! @brief one read(2), retried on EINTR
+inline std::int64_t fd_read(int fd, void * buf, std::size_t n)
+{
+	#ifdef _WIN32
+	return _read(fd, buf, static_cast<unsigned>((std::min)(n, std::size_t{1} << 30)));
+	#else
+	for (;;)
+	{
+		const auto got = ::read(fd, buf, n);
+		if (got >= 0 || errno != EINTR)
+			return got;
+	}
+	#endif
+}
+
+//! @brief write(2) until everything is written or an error occurs; returns bytes written
+inline std::size_t fd_write_all(int fd, const void * buf, std::size_t n)
+{
+	const auto * p = static_cast<const char *>(buf);
+	std::size_t done = 0;
+	while (done < n)
+	{
+		#ifdef _WIN32
+		const auto wrote = _write(fd, p + done, static_cast<unsigned>((std::min)(n - done, std::size_t{1} << 30)));
+		#else
+		const auto wrote = ::write(fd, p + done, n - done);
+		if (wrote < 0 && errno == EINTR)
+			continue;
+		#endif
+		if (wrote <= 0)
+			break;
+		done += static_cast<std::size_t>(wrote);
+	}
+	return done;
+}
+
+inline std::int64_t fd_seek(int fd, std::int64_t offset, int origin)
+{
+	#ifdef _WIN32
+	return _lseeki64(fd, offset, origin);
+	#else
+	return ::lseek(fd, static_cast<off_t>(offset), origin);
+	#endif
+}
+} // namespace details
+
+//! @brief buffered file on a raw descriptor: the file_ptr surface without stdio locking or its extra copy
+//! @note one MSL-owned buffer serves reads or writes in turn; not safe to share between threads
+class fd_file
+{
+public:
+	static constexpr std::size_t default_buffer_size = 64 * 1024;
+
+	fd_file() = default;
+	explicit fd_file(const std::string_view & path, const std::string_view & mode = "r", std::size_t buffer_size = default_buffer_size) { open(path, mode, buffer_size); }
+	//! @brief adopt an open descriptor, closed by this object
+	explicit fd_file(int fd, std::size_t buffer_size = default_buffer_size) : m_fd_(fd), m_buffer_((std::max)(buffer_size, std::size_t{1})) {}
+
+	fd_file(const fd_file &) = delete;
+	fd_file & operator=(const fd_file &) = delete;
+	fd_file(fd_file && other) noexcept { *this = std::move(other); }
+	fd_file & operator=(fd_file && other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			m_fd_ = std::exchange(other.m_fd_, -1);
+			m_buffer_ = std::move(other.m_buffer_);
+			m_begin_ = std::exchange(other.m_begin_, 0);
+			m_end_ = std::exchange(other.m_end_, 0);
+			m_pending_ = std::exchange(other.m_pending_, 0);
+			m_eof_ = std::exchange(other.m_eof_, false);
+			m_error_ = std::exchange(other.m_error_, {});
+		}
+		return *this;
+	}
+	~fd_file() { close(); }
+
+	//! @brief open path with an fopen-style mode, closing any previous file; check error() on failure
+	bool open(const std::string_view & path, const std::string_view & mode = "r", std::size_t buffer_size = default_buffer_size)
+	{
+		close();
+		m_error_ = {};
+		const int flags = details::fd_open_flags(mode);
+		if (flags < 0)
+		{
+			m_error_ = std::make_error_code(std::errc::invalid_argument);
+			return false;
+		}
+		const std::string path_str(path);
+		#ifdef _WIN32
+		m_fd_ = _open(path_str.c_str(), flags, _S_IREAD | _S_IWRITE);
+		#else
+		m_fd_ = ::open(path_str.c_str(), flags, 0666);
+		#endif
+		if (m_fd_ < 0)
+		{
+			m_error_ = {errno, std::generic_category()};
+			return false;
+		}
+		m_buffer_.resize((std::max)(buffer_size, std::size_t{1}));
+		return true;
+	}
+
+	//! @brief flush pending writes and close the descriptor
+	//! @return the first error met by the file
+	std::error_code close()
+	{
+		if (m_fd_ < 0)
+			return m_error_;
+		flush();
+		#ifdef _WIN32
+		const bool closed = _close(m_fd_) == 0;
+		#else
+		const bool closed = ::close(m_fd_) == 0;
+		#endif
+		if (!closed && !m_error_)
+			m_error_ = {errno, std::generic_category()};
+		m_fd_ = -1;
+		m_begin_ = m_end_ = m_pending_ = 0;
+		m_eof_ = false;
+		return m_error_;
+	}
+
+	bool is_open() const { return m_fd_ >= 0; }
+	explicit operator bool() const { return is_open(); }
+	bool operator!() const { return !is_open(); }
+	//! @brief the underlying descriptor
+	int fd() const { return m_fd_; }
+	std::error_code error() const { return m_error_; }
+	//! @brief true once a read hit the end of the file
+	bool eof() const { return m_eof_; }
+
+	//! @brief write bytes through the buffer (large writes go straight to the descriptor); returns bytes written
+	std::size_t write(const void * buf, std::size_t n)
+	{
+		if (m_fd_ < 0 || n == 0)
+			return 0;
+		drop_read_buffer();
+		if (m_pending_ + n > m_buffer_.size())
+		{
+			if (!flush())
+				return 0;
+			if (n >= m_buffer_.size())
+			{
+				const auto wrote = details::fd_write_all(m_fd_, buf, n);
+				if (wrote != n)
+					m_error_ = {errno, std::generic_category()};
+				return wrote;
+			}
+		}
+		std::memcpy(m_buffer_.data() + m_pending_, buf, n);
+		m_pending_ += n;
+		return n;
+	}
+	//! @brief write from span; returns bytes written
+	template <typename T> std::size_t write(std::span<const T> buffer) { return write(buffer.data(), buffer.size_bytes()); }
+	//! @brief write a single raw value using the E byte order
+	template <std::endian E = std::endian::native, typename T>
+	requires traits::is_raw_v<T>
+	bool write(const T & value)
+	{
+		static_assert(E == std::endian::native || details::byte_swappable<T>, "only arithmetic and enum values can be byte swapped");
+		if constexpr (E == std::endian::native)
+			return write(&value, sizeof(T)) == sizeof(T);
+		else
+		{
+			const auto swapped = to_endian<E>(value);
+			return write(&swapped, sizeof(T)) == sizeof(T);
+		}
+	}
+	//! @brief write into the file from string
+	std::size_t string_write(const std::string_view & str) { return write(str.data(), str.size()); }
+
+	//! @brief read up to n bytes (large reads bypass the buffer); returns bytes read
+	std::size_t read(void * buf, std::size_t n)
+	{
+		if (m_fd_ < 0 || !flush())
+			return 0;
+		auto * out = static_cast<char *>(buf);
+		std::size_t done = take_buffered(out, n);
+		while (done < n)
+		{
+			if (n - done >= m_buffer_.size())
+			{
+				const auto got = details::fd_read(m_fd_, out + done, n - done);
+				if (!note_read(got))
+					break;
+				done += static_cast<std::size_t>(got);
+				continue;
+			}
+			if (!fill())
+				break;
+			done += take_buffered(out + done, n - done);
+		}
+		return done;
+	}
+	//! @brief read n bytes (the whole remaining file if 0) into a vector, shrunk to what was read
+	std::vector<char> read(std::size_t n = 0)
+	{
+		if (n == 0)
+			n = remain_size();
+		std::vector<char> buf(n);
+		buf.resize(read(buf.data(), buf.size()));
+		return buf;
+	}
+	//! @brief read into span; returns whole elements read
+	template <typename T> std::size_t read(std::span<T> buffer) { return read(buffer.data(), buffer.size_bytes()) / sizeof(T); }
+	//! @brief read a single raw value stored with the E byte order; nullopt if the file has not enough bytes
+	template <typename T, std::endian E = std::endian::native>
+	requires traits::is_raw_v<T>
+	std::optional<T> read()
+	{
+		static_assert(E == std::endian::native || details::byte_swappable<T>, "only arithmetic and enum values can be byte swapped");
+		T value;
+		if (read(&value, sizeof(T)) != sizeof(T))
+			return std::nullopt;
+		return from_endian<E>(value);
+	}
+
+	//! @brief read the next line into line (reusing its storage), without the delimiter
+	//! @return false at the end of the file when nothing was read
+	bool getline(std::string & line, char delim = '\n')
+	{
+		line.clear();
+		if (m_fd_ < 0 || !flush())
+			return false;
+		bool any = false;
+		for (;;)
+		{
+			if (m_begin_ == m_end_ && !fill())
+				return any;
+			const char * start = m_buffer_.data() + m_begin_;
+			const auto available = m_end_ - m_begin_;
+			if (const auto * hit = static_cast<const char *>(std::memchr(start, delim, available)))
+			{
+				line.append(start, hit);
+				m_begin_ += static_cast<std::size_t>(hit - start) + 1;
+				return true;
+			}
+			line.append(start, available);
+			m_begin_ = m_end_;
+			any = true;
+		}
+	}
+	//! @brief read the next line from the current position as string
+	std::optional<std::string> getline(char delim = '\n')
+	{
+		std::string line;
+		if (!getline(line, delim))
+			return std::nullopt;
+		return line;
+	}
+
+	//! @brief logical position, accounting for buffered data
+	std::int64_t tell() const
+	{
+		const auto pos = details::fd_seek(m_fd_, 0, SEEK_CUR);
+		if (pos < 0)
+			return pos;
+		return pos + static_cast<std::int64_t>(m_pending_) - static_cast<std::int64_t>(m_end_ - m_begin_);
+	}
+
+	//! @brief seek the file (flushes pending writes and drops read-ahead)
+	bool seek(std::int64_t offset, int origin = SEEK_SET)
+	{
+		if (m_fd_ < 0 || !flush())
+			return false;
+		if (origin == SEEK_CUR)
+			offset -= static_cast<std::int64_t>(m_end_ - m_begin_);
+		m_begin_ = m_end_ = 0;
+		m_eof_ = false;
+		return details::fd_seek(m_fd_, offset, origin) >= 0;
+	}
+
+	//! @brief file size including pending writes, or the bytes left after the current position if from_current
+	std::size_t size(bool from_current = false)
+	{
+		if (m_fd_ < 0 || !flush())
+			return 0;
+		#ifdef _WIN32
+		struct _stat64 st;
+		if (_fstat64(m_fd_, &st) != 0)
+			return 0;
+		#else
+		struct stat st;
+		if (::fstat(m_fd_, &st) != 0)
+			return 0;
+		#endif
+		const auto filesize = static_cast<std::size_t>(st.st_size);
+		if (!from_current)
+			return filesize;
+		const auto cur = tell();
+		return cur < 0 ? 0 : filesize - (std::min)(filesize, static_cast<std::size_t>(cur));
+	}
+	//! @brief bytes left after the current position; alias of size(true)
+	std::size_t remain_size() { return size(true); }
+
+	//! @brief write out the pending buffer
+	bool flush()
+	{
+		if (m_pending_ == 0)
+			return !m_error_;
+		const auto wrote = details::fd_write_all(m_fd_, m_buffer_.data(), m_pending_);
+		if (wrote != m_pending_)
+		{
+			m_error_ = errno != 0 ? std::error_code(errno, std::generic_category()) : std::make_error_code(std::errc::io_error);
+			std::memmove(m_buffer_.data(), m_buffer_.data() + wrote, m_pending_ - wrote);
+			m_pending_ -= wrote;
+			return false;
+		}
+		m_pending_ = 0;
+		return !m_error_;
+	}
+
+	//! @brief flush and ask the OS to persist the file data on disk (fsync/_commit)
+	bool sync()
+	{
+		if (m_fd_ < 0 || !flush())
+			return false;
+		#ifdef _WIN32
+		return _commit(m_fd_) == 0;
+		#else
+		return ::fsync(m_fd_) == 0;
+		#endif
+	}
+
+private:
+	std::size_t take_buffered(char * out, std::size_t n)
+	{
+		const auto take = (std::min)(n, m_end_ - m_begin_);
+		if (take != 0)
+			std::memcpy(out, m_buffer_.data() + m_begin_, take);
+		m_begin_ += take;
+		return take;
+	}
+
+	bool note_read(std::int64_t got)
+	{
+		if (got < 0)
+			m_error_ = {errno, std::generic_category()};
+		else if (got == 0)
+			m_eof_ = true;
+		return got > 0;
+	}
+
+	bool fill()
+	{
+		m_begin_ = m_end_ = 0;
+		const auto got = details::fd_read(m_fd_, m_buffer_.data(), m_buffer_.size());
+		if (!note_read(got))
+			return false;
+		m_end_ = static_cast<std::size_t>(got);
+		return true;
+	}
+
+	//! @brief give unread read-ahead back to the descriptor before writing
+	void drop_read_buffer()
+	{
+		if (m_end_ != m_begin_)
+			details::fd_seek(m_fd_, -static_cast<std::int64_t>(m_end_ - m_begin_), SEEK_CUR);
+		m_begin_ = m_end_ = 0;
+	}
+
+	int m_fd_{-1};
+	std::vector<char> m_buffer_;
+	std::size_t m_begin_{0};
+	std::size_t m_end_{0};
+	std::size_t m_pending_{0};
+	bool m_eof_{false};
+	std::error_code m_error_;
+}; // fd_file
+
+} // namespace msl
+#endif // MSL_FD_FILE_H__
@@ -17,26 +17,231 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
-#include <clocale>
+#include "endian.h"
+#include "traits.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <cwchar>
 #include <format>
 #include <ios>
 #include <optional>
+#include <ranges>
 #include <span>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
 //#define MSL_FILE_PTR_ENABLE_IMPLICIT_CONVERSION
 //#define MSL_FILE_PTR_ENABLE_WIDE_STRING
 #define MSL_FILE_PTR_ENABLE_STORE_FILENAME
 
+#ifdef MSL_FILE_PTR_ENABLE_WIDE_STRING
+#include "utf8.h" // w2s and the wide open() path only
+#endif
+
 namespace msl
 {
 
+namespace details
+{
+#ifndef _WIN32
+#ifdef IOV_MAX
+inline constexpr std::size_t file_ptr_iov_batch = (IOV_MAX < 64) ? IOV_MAX : 64;
+#else
+inline constexpr std::size_t file_ptr_iov_batch = 16;
+#endif
+
+//! @brief run readv/writev until every span is transferred, EOF is reached or an error occurs; returns bytes transferred
+template <typename Byte, typename Op> std::size_t iov_transfer(int fd, std::span<const std::span<Byte>> buffers, Op && op)
+{
+	std::array<iovec, file_ptr_iov_batch> iov{};
+	std::size_t total = 0;
+	std::size_t index = 0; // first span not fully transferred
+	std::size_t offset = 0; // bytes already transferred from buffers[index]
+	while (index < buffers.size())
+	{
+		std::size_t count = 0;
+		for (auto i = index; i < buffers.size() && count < iov.size(); ++i)
+		{
+			const auto skip = (i == index) ? offset : 0;
+			if (buffers[i].size() > skip)
+				iov[count++] = {const_cast<std::byte *>(buffers[i].data()) + skip, buffers[i].size() - skip};
+		}
+		if (count == 0)
+			break;
+
+		const auto n = op(fd, iov.data(), static_cast<int>(count));
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+
+		total += static_cast<std::size_t>(n);
+		auto left = static_cast<std::size_t>(n);
+		while (index < buffers.size() && left >= buffers[index].size() - offset)
+		{
+			left -= buffers[index].size() - offset;
+			offset = 0;
+			++index;
+		}
+		offset += left;
+	}
+	return total;
+}
+
+//! @brief copy up to n bytes between descriptors inside the kernel (copy_file_range, then sendfile)
+//! @note offsets advance by the bytes copied; at_end reports EOF, otherwise a short count means "not supported here"
+inline std::uint64_t kernel_copy([[maybe_unused]] int in_fd, [[maybe_unused]] off_t & in_off, [[maybe_unused]] int out_fd,
+	[[maybe_unused]] off_t & out_off, std::uint64_t n, bool & at_end)
+{
+	constexpr std::uint64_t max_step = std::uint64_t{1} << 30;
+	std::uint64_t done = 0;
+	at_end = false;
+	#if defined(__linux__) && defined(SYS_copy_file_range)
+	while (done < n)
+	{
+		loff_t in = in_off;
+		loff_t out = out_off;
+		const auto r = ::syscall(SYS_copy_file_range, in_fd, &in, out_fd, &out, static_cast<std::size_t>((std::min)(n - done, max_step)), 0u);
+		if (r < 0 && errno == EINTR)
+			continue;
+		if (r < 0)
+			break; // EXDEV, ENOSYS, EINVAL, EBADF (O_APPEND)...: try sendfile
+		if (r == 0)
+		{
+			at_end = true;
+			return done;
+		}
+		in_off += static_cast<off_t>(r);
+		out_off += static_cast<off_t>(r);
+		done += static_cast<std::uint64_t>(r);
+	}
+	#endif
+	#ifdef __linux__
+	// sendfile writes at the output descriptor offset
+	if (done < n && ::lseek(out_fd, out_off, SEEK_SET) == out_off)
+	{
+		while (done < n)
+		{
+			off_t in = in_off;
+			const auto r = ::sendfile(out_fd, in_fd, &in, static_cast<std::size_t>((std::min)(n - done, max_step)));
+			if (r < 0 && errno == EINTR)
+				continue;
+			if (r < 0)
+				break;
+			if (r == 0)
+			{
+				at_end = true;
+				break;
+			}
+			in_off += static_cast<off_t>(r);
+			done += static_cast<std::uint64_t>(r);
+		}
+		out_off = ::lseek(out_fd, 0, SEEK_CUR);
+	}
+	#endif
+	return done;
+}
+#endif
+
+//! @brief getc/fread/fwrite without the per-call stream lock (_nolock on Windows, *_unlocked on POSIX)
+inline int getc_nolock(std::FILE * file)
+{
+	#ifdef _WIN32
+	return _getc_nolock(file);
+	#else
+	return getc_unlocked(file);
+	#endif
+}
+
+inline std::size_t fread_nolock(void * buf, std::size_t size, std::size_t n, std::FILE * file)
+{
+	#ifdef _WIN32
+	return _fread_nolock(buf, size, n, file);
+	#elif defined(__GLIBC__)
+	return fread_unlocked(buf, size, n, file);
+	#else
+	return std::fread(buf, size, n, file);
+	#endif
+}
+
+inline std::size_t fwrite_nolock(const void * buf, std::size_t size, std::size_t n, std::FILE * file)
+{
+	#ifdef _WIN32
+	return _fwrite_nolock(buf, size, n, file);
+	#elif defined(__GLIBC__)
+	return fwrite_unlocked(buf, size, n, file);
+	#else
+	return std::fwrite(buf, size, n, file);
+	#endif
+}
+
+//! @brief holds the stream lock for a scope so that a sequence of *_nolock calls stays thread-safe
+class stdio_lock
+{
+public:
+	explicit stdio_lock(std::FILE * file) : m_file_(file)
+	{
+		#ifdef _WIN32
+		_lock_file(m_file_);
+		#else
+		flockfile(m_file_);
+		#endif
+	}
+	stdio_lock(const stdio_lock &) = delete;
+	stdio_lock & operator=(const stdio_lock &) = delete;
+	~stdio_lock()
+	{
+		#ifdef _WIN32
+		_unlock_file(m_file_);
+		#else
+		funlockfile(m_file_);
+		#endif
+	}
+
+private:
+	std::FILE * m_file_;
+};
+
+//! @brief read up to delim with unlocked getc; the caller holds the lock or owns the stream
+inline std::optional<std::string> getline_nolock(std::FILE * file, char delim)
+{
+	std::string ret;
+	int buf;
+	while ((buf = getc_nolock(file)) != EOF)
+	{
+		if (buf == delim) // if newline, return the current line
+			return ret;
+		ret += static_cast<char>(buf);
+	}
+	return (ret.empty()) ? std::nullopt : std::optional<std::string>{ret};
+}
+} // namespace details
+
 class file_ptr
 {
 	std::FILE * m_ptr_{nullptr};
@@ -134,32 +339,12 @@ public:
 	}
 
 	#ifdef MSL_FILE_PTR_ENABLE_WIDE_STRING
+	//! @brief w2s converts a UTF-16 (Windows) or UTF-32 (elsewhere) wide string to UTF-8 without touching the C locale
 	inline static std::optional<std::string> w2s(const std::wstring_view & wcstr)
 	{
-		// on Windows, UTF-16 is internal Unicode encoding (UCS2 before WinXP)
-		// on Linux, UCS4 is internal Unicode encoding
-		// on BSD, UCS4 is internal Unicode encoding
-		setlocale(LC_ALL, "en_US.UTF-8");
-		const wchar_t * wcs = wcstr.data(); // implicit conversion for compatibility
-		auto s = std::mbstate_t();
-
-		#if _WIN32
-		size_t target_char_count{};
-		if (wcsrtombs_s(&target_char_count, nullptr, 0, &wcs, 0, &s) != 0)
+		std::string str;
+		if (utf8_from_wide(wcstr, str))
 			return {};
-		#else
-		auto target_char_count = std::wcsrtombs(nullptr, &wcs, 0, &s);
-		if (target_char_count == static_cast<std::size_t>(-1))
-			return {};
-		target_char_count++; // +1 because std::string adds a null terminator which isn't part of size
-		#endif
-
-		auto str = std::string(target_char_count, '\0');
-		#if _WIN32
-		wcsrtombs_s(&target_char_count, str.data(), str.size(), &wcs, str.size(), &s);
-		#else
-		std::wcsrtombs(str.data(), &wcs, str.size(), &s);
-		#endif
 		return str;
 	}
 
@@ -271,14 +456,89 @@ public:
 	std::size_t write(const std::vector<char> & vec) const { return std::fwrite(vec.data(), 1, vec.size(), m_ptr_); }
 	//! @brief write into the file from c array
 	std::size_t write(const void * buf, std::size_t size) const { return std::fwrite(buf, 1, size, m_ptr_); }
+	//! @brief write without the stream lock, for files used by a single thread at a time
+	std::size_t write_unlocked(const void * buf, std::size_t size) const { return details::fwrite_nolock(buf, 1, size, m_ptr_); }
 	//! @brief write into the file from span
 	template <typename T> std::size_t write(std::span<const T> buffer) const
 	{
 		return std::fwrite(buffer.data(), sizeof(T), buffer.size(), m_ptr_) * sizeof(T);
 	}
 
+	//! @brief write a single raw value using the E byte order
+	template <std::endian E = std::endian::native, typename T>
+	requires traits::is_raw_v<T>
+	bool write(const T & value) const
+	{
+		static_assert(E == std::endian::native || details::byte_swappable<T>, "only arithmetic and enum values can be byte swapped");
+		if constexpr (E == std::endian::native)
+			return std::fwrite(&value, sizeof(T), 1, m_ptr_) == 1;
+		else
+		{
+			const auto swapped = to_endian<E>(value);
+			return std::fwrite(&swapped, sizeof(T), 1, m_ptr_) == 1;
+		}
+	}
+
+	//! @brief write an array of raw values using the E byte order; returns elements written
+	template <std::endian E = std::endian::native, std::ranges::contiguous_range R>
+	requires traits::is_raw_v<std::ranges::range_value_t<R>>
+	std::size_t write_array(const R & range) const
+	{
+		using T = std::ranges::range_value_t<R>;
+		const std::span<const T> values(std::ranges::data(range), std::ranges::size(range));
+		static_assert(E == std::endian::native || details::byte_swappable<T>, "only arithmetic and enum values can be byte swapped");
+		if constexpr (E == std::endian::native)
+			return std::fwrite(values.data(), sizeof(T), values.size(), m_ptr_);
+		else
+		{
+			// swap through a fixed staging batch instead of copying the whole array
+			std::array<T, (4096 / sizeof(T)) ? (4096 / sizeof(T)) : 1> batch;
+			std::size_t written = 0;
+			while (written < values.size())
+			{
+				const auto count = (std::min)(batch.size(), values.size() - written);
+				std::copy_n(values.data() + written, count, batch.data());
+				convert_endian_in_place<E>(std::span(batch.data(), count));
+				const auto n = std::fwrite(batch.data(), sizeof(T), count, m_ptr_);
+				written += n;
+				if (n != count)
+					break;
+			}
+			return written;
+		}
+	}
+
+	//! @brief gather-write all the spans in order with a single writev call; returns bytes written
+	//! @note the stdio buffer is flushed first so previously buffered writes keep their order
+	std::size_t write_v(std::span<const std::span<const std::byte>> buffers) const
+	{
+		#ifdef _WIN32
+		std::size_t written = 0;
+		_lock_file(m_ptr_);
+		for (const auto & buf : buffers)
+		{
+			const auto n = _fwrite_nolock(buf.data(), 1, buf.size(), m_ptr_);
+			written += n;
+			if (n != buf.size())
+				break;
+		}
+		_unlock_file(m_ptr_);
+		return written;
+		#else
+		if (std::fflush(m_ptr_) != 0)
+			return 0;
+		const auto fd = ::fileno(m_ptr_);
+		const auto written = details::iov_transfer(fd, buffers, ::writev);
+		if (const auto pos = ::lseek(fd, 0, SEEK_CUR); pos >= 0)
+			::fseeko(m_ptr_, pos, SEEK_SET); // drop any cached stdio offset
+		return written;
+		#endif
+	}
+
 	//! @brief write into the file from string
 	std::size_t string_write(const std::string_view & str) const { return std::fwrite(str.data(), 1, str.size(), m_ptr_); }
+	//! @brief string_write without the stream lock, for files used by a single thread at a time
+	std::size_t string_write_unlocked(const std::string_view & str) const { return details::fwrite_nolock(str.data(), 1, str.size(), m_ptr_); }
 
 	#ifdef MSL_FILE_PTR_ENABLE_WIDE_STRING
 	//! @brief write into the file from wstring
@@ -302,6 +562,9 @@ public:
 		return std::fread(buf, 1, n, m_ptr_);
 	}
 
+	//! @brief fread without the stream lock, for files used by a single thread at a time
+	std::size_t fread_unlocked(void * buf, std::size_t n) const { return details::fread_nolock(buf, 1, n, m_ptr_); }
+
 	//! @brief read the file from the current position as byte stream using a buffer
 	std::size_t read(void * buf, std::size_t n = 0) const
 	{
@@ -316,26 +579,125 @@ public:
 		return std::fread(buffer.data(), sizeof(T), buffer.size(), m_ptr_);
 	}
 
-	//! @brief read the next line from the current position as string
-	std::optional<std::string> getline(char delim = '\n') const
+	//! @brief read a single raw value stored with the E byte order; nullopt if the file has not enough bytes
+	template <typename T, std::endian E = std::endian::native>
+	requires traits::is_raw_v<T>
+	std::optional<T> read() const
 	{
-		std::string ret;
-		int buf;
-		while ((buf = std::fgetc(m_ptr_)) != EOF)
+		static_assert(E == std::endian::native || details::byte_swappable<T>, "only arithmetic and enum values can be byte swapped");
+		T value;
+		if (std::fread(&value, sizeof(T), 1, m_ptr_) != 1)
+			return std::nullopt;
+		return from_endian<E>(value);
+	}
+
+	//! @brief read up to values.size() raw values stored with the E byte order; returns elements read
+	template <std::endian E = std::endian::native, typename T, std::size_t Extent>
+	requires traits::is_raw_v<T>
+	std::size_t read_array(std::span<T, Extent> values) const
+	{
+		static_assert(E == std::endian::native || details::byte_swappable<T>, "only arithmetic and enum values can be byte swapped");
+		const auto got = std::fread(values.data(), sizeof(T), values.size(), m_ptr_);
+		if constexpr (E != std::endian::native)
+			convert_endian_in_place<E>(values.first(got));
+		return got;
+	}
+
+	//! @brief read up to n raw values stored with the E byte order returning a vector
+	template <typename T, std::endian E = std::endian::native>
+	requires traits::is_raw_v<T>
+	std::vector<T> read_array(std::size_t n) const
+	{
+		std::vector<T> values(n);
+		values.resize(read_array<E>(std::span<T>(values)));
+		return values;
+	}
+
+	//! @brief scatter-read into all the spans in order with a single readv call; returns bytes read
+	//! @note buffered stdio data is accounted for by reading from the current logical position
+	std::size_t read_v(std::span<const std::span<std::byte>> buffers) const
+	{
+		#ifndef _WIN32
+		const auto pos = ::ftello(m_ptr_);
+		const auto fd = ::fileno(m_ptr_);
+		if (pos >= 0 && std::fflush(m_ptr_) == 0 && ::lseek(fd, pos, SEEK_SET) == pos)
+		{
+			const auto got = details::iov_transfer(fd, buffers, ::readv);
+			::fseeko(m_ptr_, pos + static_cast<off_t>(got), SEEK_SET);
+			return got;
+		}
+		#endif
+		// Windows and non-seekable streams keep going through stdio to preserve its buffered data
+		std::size_t got = 0;
+		for (const auto & buf : buffers)
 		{
-			if (buf == delim) // if newline, return the current line
-				return ret;
-			ret += static_cast<char>(buf);
+			const auto n = std::fread(buf.data(), 1, buf.size(), m_ptr_);
+			got += n;
+			if (n != buf.size())
+				break;
 		}
-		return (ret.empty()) ? std::nullopt : std::optional<std::string>{ret};
+		return got;
 	}
 
+	//! @brief copy up to n bytes from the current position into dst at its current position; returns bytes copied
+	//! @note stays in the kernel with copy_file_range/sendfile where possible, otherwise loops fread/fwrite in 1 MiB chunks
+	std::uint64_t copy_to(const file_ptr & dst, std::uint64_t n = UINT64_MAX) const
+	{
+		std::uint64_t done = 0;
+		#ifndef _WIN32
+		auto in_off = ::ftello(m_ptr_);
+		auto out_off = ::ftello(dst.m_ptr_);
+		if (in_off >= 0 && out_off >= 0 && std::fflush(m_ptr_) == 0 && std::fflush(dst.m_ptr_) == 0)
+		{
+			bool at_end = false;
+			done = details::kernel_copy(::fileno(m_ptr_), in_off, ::fileno(dst.m_ptr_), out_off, n, at_end);
+			::fseeko(m_ptr_, in_off, SEEK_SET);
+			if (out_off >= 0)
+				::fseeko(dst.m_ptr_, out_off, SEEK_SET);
+			if (at_end || done == n)
+				return done;
+		}
+		#endif
+		std::vector<char> buffer(static_cast<std::size_t>((std::min)(n - done, std::uint64_t{1} << 20)));
+		while (done < n)
+		{
+			const auto want = static_cast<std::size_t>((std::min)(n - done, static_cast<std::uint64_t>(buffer.size())));
+			const auto got = std::fread(buffer.data(), 1, want, m_ptr_);
+			const auto wrote = std::fwrite(buffer.data(), 1, got, dst.m_ptr_);
+			done += wrote;
+			if (got != want || wrote != got)
+				break;
+		}
+		return done;
+	}
+
+	//! @brief read the next line from the current position as string
+	//! @note the stream lock is taken once per line rather than once per character
+	std::optional<std::string> getline(char delim = '\n') const
+	{
+		const details::stdio_lock lock(m_ptr_);
+		return details::getline_nolock(m_ptr_, delim);
+	}
+
+	//! @brief getline without the stream lock, for files used by a single thread at a time
+	std::optional<std::string> getline_unlocked(char delim = '\n') const { return details::getline_nolock(m_ptr_, delim); }
+
 	//! @brief tell the file
 	long tell() const
 	{
 		return std::ftell(m_ptr_);
 	}
 
+	//! @brief tell the file with a 64-bit offset (long is 32-bit on Windows)
+	std::int64_t tell64() const
+	{
+		#ifdef _WIN32
+		return _ftelli64(m_ptr_);
+		#else
+		return static_cast<std::int64_t>(::ftello(m_ptr_));
+		#endif
+	}
+
 	//! @brief seek the file
 	void seek(long offset, int origin = SEEK_SET) const
 	{
@@ -375,6 +737,79 @@ public:
 		std::fflush(m_ptr_);
 	}
 
+	//! @brief flush the stdio buffer and ask the OS to persist the file data on disk (fsync/_commit)
+	bool sync() const
+	{
+		if (std::fflush(m_ptr_) != 0)
+			return false;
+		#ifdef _WIN32
+		return _commit(_fileno(m_ptr_)) == 0;
+		#else
+		return ::fsync(::fileno(m_ptr_)) == 0;
+		#endif
+	}
+
+	//! @brief flush, then reserve disk blocks for the next bytes bytes after the current position
+	//! @note keep_size leaves the file size alone (FALLOC_FL_KEEP_SIZE on Linux, F_PREALLOCATE on macOS) and returns
+	//! operation_not_supported where that is impossible; otherwise the file is extended with zeroes (posix_fallocate)
+	std::error_code preallocate(std::uint64_t bytes, bool keep_size = true) const
+	{
+		if (!m_ptr_)
+			return std::make_error_code(std::errc::bad_file_descriptor);
+		if (std::fflush(m_ptr_) != 0)
+			return {errno, std::generic_category()};
+		const auto offset = tell64();
+		if (offset < 0)
+			return {errno, std::generic_category()};
+		#ifdef _WIN32
+		if (keep_size)
+			return std::make_error_code(std::errc::operation_not_supported);
+		const int fd = _fileno(m_ptr_);
+		const auto end = static_cast<__int64>(offset) + static_cast<__int64>(bytes);
+		if (_filelengthi64(fd) < end && _chsize_s(fd, end) != 0)
+			return {errno, std::generic_category()};
+		return {};
+		#else
+		const int fd = ::fileno(m_ptr_);
+		#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+		if (::fallocate(fd, keep_size ? FALLOC_FL_KEEP_SIZE : 0, offset, static_cast<off_t>(bytes)) == 0)
+			return {};
+		if (keep_size || errno != EOPNOTSUPP)
+			return {errno, std::generic_category()};
+		const int rc = ::posix_fallocate(fd, offset, static_cast<off_t>(bytes));
+		return rc == 0 ? std::error_code{} : std::error_code(rc, std::generic_category());
+		#elif defined(__APPLE__)
+		// F_PEOFPOSMODE allocates after the physical end of file (F_VOLPOSMODE offsets are volume-relative):
+		// only ask for what the blocks already allocated do not cover up to offset + bytes
+		struct stat st;
+		if (::fstat(fd, &st) != 0)
+			return {errno, std::generic_category()};
+		const auto end = static_cast<off_t>(offset) + static_cast<off_t>(bytes);
+		const auto physical_end = static_cast<off_t>(st.st_blocks) * 512;
+		if (physical_end < end)
+		{
+			fstore_t store{F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, end - physical_end, 0};
+			if (::fcntl(fd, F_PREALLOCATE, &store) != 0)
+			{
+				store.fst_flags = F_ALLOCATEALL;
+				if (::fcntl(fd, F_PREALLOCATE, &store) != 0)
+					return {errno, std::generic_category()};
+			}
+		}
+		if (keep_size)
+			return {};
+		if (st.st_size < end && ::ftruncate(fd, end) != 0)
+			return {errno, std::generic_category()};
+		return {};
+		#else
+		if (keep_size)
+			return std::make_error_code(std::errc::operation_not_supported);
+		const int rc = ::posix_fallocate(fd, offset, static_cast<off_t>(bytes));
+		return rc == 0 ? std::error_code{} : std::error_code(rc, std::generic_category());
+		#endif
+		#endif
+	}
+
 	//! @brief check if the opened file stream has errors
 	[[nodiscard]] bool error() const noexcept { return std::ferror(m_ptr_) != 0; }
 
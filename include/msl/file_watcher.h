@@ -0,0 +1,490 @@
+#ifndef MSL_FILE_WATCHER_H__
+#define MSL_FILE_WATCHER_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<sys/inotify.h>)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define MSL_FILE_WATCHER_HAS_INOTIFY
+#endif
+
+namespace msl
+{
+
+//! @brief change kinds carried by file_event::changes (several may be merged into one event)
+enum file_change : std::uint32_t
+{
+	file_modified = 1u << 0,
+	file_created = 1u << 1,
+	file_removed = 1u << 2,
+	//! @brief the kernel event queue overflowed and changes to this path may have been lost: re-check it
+	file_overflow = 1u << 3,
+};
+
+struct file_event
+{
+	std::string path; // as passed to watch() for files, directory + '/' + name for directory watches
+	std::uint32_t changes{0};
+
+	bool has(file_change change) const { return (changes & change) != 0; }
+};
+
+struct file_watcher_options
+{
+	std::chrono::milliseconds coalesce{50}; // quiet period that closes a burst of events
+	std::chrono::milliseconds max_delay{1000}; // upper bound for holding back a continuous burst
+	std::chrono::milliseconds poll_interval{500}; // stat polling period where inotify is unavailable
+};
+
+//! @brief watches files and directories and reports coalesced changes through poll() or a callback thread
+//! @note single files are watched through their parent directory, so atomic rename-over saves are seen too
+class file_watcher
+{
+public:
+	using callback_type = std::function<void(const file_event &)>;
+
+	explicit file_watcher(file_watcher_options options = {}) : m_options_(options)
+	{
+		#ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+		m_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_fd_ < 0 || ::pipe2(m_wake_, O_NONBLOCK | O_CLOEXEC) != 0)
+			m_error_ = {errno, std::generic_category()};
+		#endif
+	}
+
+	file_watcher(const file_watcher &) = delete;
+	file_watcher & operator=(const file_watcher &) = delete;
+
+	~file_watcher()
+	{
+		stop();
+		#ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+		for (const int fd : {m_fd_, m_wake_[0], m_wake_[1]})
+		{
+			if (fd >= 0)
+				::close(fd);
+		}
+		#endif
+	}
+
+	//! @brief start watching a file or a directory (non-recursive); the directory of a file must exist
+	std::error_code watch(const std::string_view & path)
+	{
+		if (m_error_)
+			return m_error_;
+		std::error_code ec;
+		const std::filesystem::path fs_path(std::string{path});
+		const bool is_directory = std::filesystem::is_directory(fs_path, ec);
+		auto directory = is_directory ? fs_path.string() : fs_path.parent_path().string();
+		if (directory.empty())
+			directory = ".";
+
+		std::lock_guard<std::mutex> lock(m_mutex_);
+		#ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+		const int wd = ::inotify_add_watch(m_fd_, directory.c_str(), watch_mask);
+		if (wd < 0)
+			return {errno, std::generic_category()};
+		auto & dir = m_dirs_[wd];
+		dir.path = directory;
+		if (is_directory)
+			dir.whole = true;
+		else
+			dir.files[fs_path.filename().string()] = std::string(path);
+		// watching a file of a removed directory again: merge with the one waiting to be re-armed
+		std::erase_if(m_lost_, [&](watched_dir & lost) {
+			if (lost.path != directory)
+				return false;
+			dir.whole = dir.whole || lost.whole;
+			dir.files.merge(lost.files);
+			return true;
+		});
+		#else
+		m_watches_[std::string(path)] = {is_directory, snapshot(std::string(path), is_directory)};
+		#endif
+		return {};
+	}
+
+	//! @brief stop reporting a path given to watch()
+	void unwatch(const std::string_view & path)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex_);
+		#ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+		for (auto it = m_dirs_.begin(); it != m_dirs_.end(); ++it)
+		{
+			auto & dir = it->second;
+			if (dir.whole && dir.path == path)
+				dir.whole = false;
+			std::erase_if(dir.files, [&](const auto & entry) { return entry.second == path; });
+			if (!dir.whole && dir.files.empty())
+			{
+				::inotify_rm_watch(m_fd_, it->first);
+				m_dirs_.erase(it);
+				break;
+			}
+		}
+		for (auto & dir : m_lost_)
+		{
+			if (dir.whole && dir.path == path)
+				dir.whole = false;
+			std::erase_if(dir.files, [&](const auto & entry) { return entry.second == path; });
+		}
+		std::erase_if(m_lost_, [](const watched_dir & dir) { return !dir.whole && dir.files.empty(); });
+		#else
+		m_watches_.erase(std::string(path));
+		#endif
+	}
+
+	//! @brief wait up to timeout for changes and return them coalesced per path (empty on timeout)
+	std::vector<file_event> poll(std::chrono::milliseconds timeout)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		std::vector<file_event> events;
+		std::unordered_map<std::string, std::size_t> index;
+		const auto add = [&](std::string path, std::uint32_t changes) {
+			if (const auto it = index.find(path); it != index.end())
+			{
+				events[it->second].changes |= changes;
+				return;
+			}
+			index.emplace(path, events.size());
+			events.push_back({std::move(path), changes});
+		};
+
+		auto wait = timeout;
+		std::chrono::steady_clock::time_point first_event;
+		for (;;)
+		{
+			const bool any = wait_and_collect(wait, add);
+			if (m_stop_.load(std::memory_order_acquire))
+				break;
+			const auto now = std::chrono::steady_clock::now();
+			if (events.empty())
+			{
+				const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
+				if (elapsed >= timeout)
+					break;
+				wait = timeout - elapsed;
+				continue;
+			}
+			if (!any)
+				break; // the burst went quiet for a whole coalesce period
+			if (first_event == std::chrono::steady_clock::time_point{})
+				first_event = now;
+			else if (now - first_event >= m_options_.max_delay)
+				break;
+			wait = m_options_.coalesce;
+		}
+		return events;
+	}
+
+	//! @brief deliver every coalesced event to callback on a background thread until stop()
+	void start(callback_type callback)
+	{
+		stop();
+		m_stop_.store(false, std::memory_order_release);
+		m_thread_ = std::thread([this, callback = std::move(callback)] {
+			while (!m_stop_.load(std::memory_order_acquire))
+			{
+				for (const auto & event : poll(std::chrono::milliseconds(1000)))
+					callback(event);
+			}
+		});
+	}
+
+	//! @brief stop the callback thread (waits for the callback in flight)
+	void stop()
+	{
+		if (!m_thread_.joinable())
+			return;
+		m_stop_.store(true, std::memory_order_release);
+		#ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+		const char byte = 0;
+		[[maybe_unused]] const auto n = ::write(m_wake_[1], &byte, 1);
+		#endif
+		m_thread_.join();
+		#ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+		char drain[16];
+		while (::read(m_wake_[0], drain, sizeof(drain)) > 0)
+		{
+		}
+		#endif
+		m_stop_.store(false, std::memory_order_release);
+	}
+
+	std::error_code error() const { return m_error_; }
+
+private:
+	#ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+	struct watched_dir
+	{
+		std::string path;
+		bool whole{false};
+		std::unordered_map<std::string, std::string> files; // name -> path given to watch()
+	};
+
+	static constexpr std::uint32_t watch_mask =
+		IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+
+	//! @brief report every path a directory entry stands for
+	template <typename Add> static void add_all(const watched_dir & dir, std::uint32_t changes, Add & add)
+	{
+		if (dir.whole)
+			add(dir.path, changes);
+		for (const auto & [name, path] : dir.files)
+			add(path, changes);
+	}
+
+	//! @brief the watched directory was removed or moved away: report it and wait for it to come back
+	template <typename Add> void lose_locked(std::map<int, watched_dir>::iterator it, Add & add)
+	{
+		add_all(it->second, file_removed, add);
+		::inotify_rm_watch(m_fd_, it->first); // a moved directory keeps its watch: drop it (fails harmlessly otherwise)
+		m_lost_.push_back(std::move(it->second));
+		m_dirs_.erase(it);
+	}
+
+	//! @brief watch again the removed directories that exist again (e.g. replaced by a rename or recreated)
+	template <typename Add> bool rearm_locked(Add & add)
+	{
+		bool any = false;
+		std::erase_if(m_lost_, [&](watched_dir & lost) {
+			const int wd = ::inotify_add_watch(m_fd_, lost.path.c_str(), watch_mask);
+			if (wd < 0)
+				return false;
+			std::error_code ec;
+			if (lost.whole)
+				add(lost.path, file_created);
+			for (const auto & [name, path] : lost.files)
+			{
+				if (std::filesystem::exists(path, ec))
+					add(path, file_created);
+			}
+			auto & dir = m_dirs_[wd];
+			dir.path = lost.path;
+			dir.whole = dir.whole || lost.whole;
+			dir.files.merge(lost.files);
+			any = true;
+			return true;
+		});
+		return any;
+	}
+
+	//! @brief wait for inotify data (or a wake-up) and translate it; false if nothing arrived in time
+	template <typename Add> bool wait_and_collect(std::chrono::milliseconds wait, Add & add)
+	{
+		if (m_fd_ < 0)
+			return false;
+		bool rearmed = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex_);
+			if (!m_lost_.empty())
+			{
+				rearmed = rearm_locked(add);
+				// removed directories are retried every poll_interval
+				if (!m_lost_.empty())
+					wait = (std::min)(wait, m_options_.poll_interval);
+			}
+		}
+		if (rearmed)
+			return true;
+		pollfd fds[2] = {{m_fd_, POLLIN, 0}, {m_wake_[0], POLLIN, 0}};
+		int ready;
+		do
+			ready = ::poll(fds, 2, static_cast<int>(wait.count()));
+		while (ready < 0 && errno == EINTR);
+		if (ready <= 0 || (fds[0].revents & POLLIN) == 0)
+			return false;
+
+		alignas(inotify_event) char buffer[16384];
+		bool any = false;
+		for (;;)
+		{
+			const auto n = ::read(m_fd_, buffer, sizeof(buffer));
+			if (n <= 0)
+				break;
+			std::lock_guard<std::mutex> lock(m_mutex_);
+			for (const char * p = buffer; p < buffer + n;)
+			{
+				const auto * event = reinterpret_cast<const inotify_event *>(p);
+				p += sizeof(inotify_event) + event->len;
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					// events were dropped by the kernel: every watched path may have changed
+					for (const auto & [wd, dir] : m_dirs_)
+						add_all(dir, file_overflow, add);
+					any = true;
+					continue;
+				}
+				const auto it = m_dirs_.find(event->wd);
+				if (it == m_dirs_.end())
+					continue;
+				if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT))
+				{
+					lose_locked(it, add);
+					rearm_locked(add);
+					any = true;
+					continue;
+				}
+				if (event->len == 0)
+					continue;
+				const std::string name(event->name);
+				std::uint32_t changes = 0;
+				if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB))
+					changes |= file_modified;
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+					changes |= file_created;
+				if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+					changes |= file_removed;
+				if (const auto file = it->second.files.find(name); file != it->second.files.end())
+				{
+					add(file->second, changes);
+					any = true;
+				}
+				else if (it->second.whole)
+				{
+					add(it->second.path + '/' + name, changes);
+					any = true;
+				}
+			}
+		}
+		return any;
+	}
+
+	int m_fd_{-1};
+	int m_wake_[2]{-1, -1};
+	std::map<int, watched_dir> m_dirs_;
+	std::vector<watched_dir> m_lost_; // removed directories waiting to be watched again
+	#else
+	struct file_state
+	{
+		bool exists{false};
+		std::uintmax_t size{0};
+		std::filesystem::file_time_type mtime{};
+		bool operator==(const file_state &) const = default;
+	};
+	struct watch_entry
+	{
+		bool directory{false};
+		std::map<std::string, file_state> states;
+	};
+
+	static file_state stat_path(const std::filesystem::path & path)
+	{
+		std::error_code ec;
+		file_state state;
+		state.size = std::filesystem::file_size(path, ec);
+		state.exists = !ec;
+		if (state.exists)
+			state.mtime = std::filesystem::last_write_time(path, ec);
+		else
+			state.size = 0;
+		return state;
+	}
+
+	static std::map<std::string, file_state> snapshot(const std::string & path, bool directory)
+	{
+		std::map<std::string, file_state> states;
+		if (!directory)
+		{
+			states[path] = stat_path(path);
+			return states;
+		}
+		std::error_code ec;
+		for (const auto & entry : std::filesystem::directory_iterator(path, ec))
+			states[path + '/' + entry.path().filename().string()] = stat_path(entry.path());
+		return states;
+	}
+
+	//! @brief stat polling: diff every watch against its last snapshot each poll_interval
+	template <typename Add> bool wait_and_collect(std::chrono::milliseconds wait, Add & add)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + wait;
+		for (;;)
+		{
+			bool any = false;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex_);
+				for (auto & [path, watch] : m_watches_)
+				{
+					auto current = snapshot(path, watch.directory);
+					for (const auto & [name, state] : current)
+					{
+						const auto old = watch.states.find(name);
+						const bool existed = old != watch.states.end() && old->second.exists;
+						std::uint32_t changes = 0;
+						if (state.exists && !existed)
+							changes = file_created;
+						else if (!state.exists && existed)
+							changes = file_removed;
+						else if (state.exists && !(old->second == state))
+							changes = file_modified;
+						if (changes != 0)
+						{
+							add(name, changes);
+							any = true;
+						}
+					}
+					for (const auto & [name, state] : watch.states)
+					{
+						if (state.exists && !current.contains(name))
+						{
+							add(name, file_removed);
+							any = true;
+						}
+					}
+					watch.states = std::move(current);
+				}
+			}
+			if (any || m_stop_.load(std::memory_order_acquire) || std::chrono::steady_clock::now() >= deadline)
+				return any;
+			std::this_thread::sleep_for((std::min)(m_options_.poll_interval, std::chrono::duration_cast<std::chrono::milliseconds>(
+				deadline - std::chrono::steady_clock::now()) + std::chrono::milliseconds(1)));
+		}
+	}
+
+	std::map<std::string, watch_entry> m_watches_;
+	#endif
+
+	file_watcher_options m_options_;
+	std::mutex m_mutex_;
+	std::atomic<bool> m_stop_{false};
+	std::thread m_thread_;
+	std::error_code m_error_;
+}; // file_watcher
+
+} // namespace msl
+#endif // MSL_FILE_WATCHER_H__
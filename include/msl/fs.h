@@ -0,0 +1,569 @@
+#ifndef MSL_FS_H__
+#define MSL_FS_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace msl
+{
+
+namespace details
+{
+//! @brief file size through fstat, without moving the stdio position
+inline std::optional<std::uint64_t> stat_size(std::FILE * file)
+{
+	#ifdef _WIN32
+	struct _stat64 st;
+	if (_fstat64(_fileno(file), &st) != 0)
+		return std::nullopt;
+	#else
+	struct stat st;
+	if (::fstat(::fileno(file), &st) != 0)
+		return std::nullopt;
+	#endif
+	return static_cast<std::uint64_t>(st.st_size);
+}
+
+//! @brief whether path names the file already open from opened_path (same device and inode)
+inline bool same_file(std::FILE * file, const std::string_view & opened_path, const std::string_view & path)
+{
+	#ifdef _WIN32
+	(void)file;
+	std::error_code ec;
+	return std::filesystem::equivalent(std::filesystem::path(std::string{opened_path}), std::filesystem::path(std::string{path}), ec) && !ec;
+	#else
+	(void)opened_path;
+	struct stat open_st;
+	struct stat path_st;
+	if (::fstat(::fileno(file), &open_st) != 0 || ::stat(std::string(path).c_str(), &path_st) != 0)
+		return false;
+	return open_st.st_dev == path_st.st_dev && open_st.st_ino == path_st.st_ino;
+	#endif
+}
+
+inline std::error_code last_error_or(std::errc fallback)
+{
+	return errno != 0 ? std::error_code(errno, std::generic_category()) : std::make_error_code(fallback);
+}
+} // namespace details
+
+struct loaded_file
+{
+	std::string path;
+	std::vector<char> data;
+	std::error_code error;
+
+	explicit operator bool() const { return !error; }
+};
+
+//! @brief load_file reads a whole file into a buffer pre-sized from fstat
+inline loaded_file load_file(const std::string_view & path)
+{
+	loaded_file ret{std::string(path), {}, {}};
+	errno = 0;
+	file_ptr file(path, "rb");
+	if (!file)
+	{
+		ret.error = details::last_error_or(std::errc::no_such_file_or_directory);
+		return ret;
+	}
+
+	const auto size = details::stat_size(file.get());
+	if (!size)
+	{
+		ret.error = details::last_error_or(std::errc::io_error);
+		return ret;
+	}
+
+	ret.data.resize(static_cast<std::size_t>(*size));
+	ret.data.resize(file.fread(ret.data.data(), ret.data.size()));
+	if (file.error())
+		ret.error = std::make_error_code(std::errc::io_error);
+	else if (*size == 0)
+	{
+		// pseudo files (procfs and alike) report size 0: read until EOF
+		char tail[4096];
+		while (const auto n = file.fread(tail, sizeof(tail)))
+			ret.data.insert(ret.data.end(), tail, tail + n);
+	}
+	return ret;
+}
+
+//! @brief load_files opens and reads every path concurrently; results keep the input order
+//! @param parallelism worker count including the calling thread; 0 picks std::thread::hardware_concurrency()
+template <std::ranges::sized_range Range>
+requires std::convertible_to<std::ranges::range_reference_t<const Range>, std::string_view>
+std::vector<loaded_file> load_files(const Range & paths, std::size_t parallelism = 0)
+{
+	std::vector<std::string_view> views;
+	views.reserve(std::ranges::size(paths));
+	for (const auto & path : paths)
+		views.emplace_back(path);
+
+	std::vector<loaded_file> results(views.size());
+	if (parallelism == 0)
+		parallelism = (std::max)(std::thread::hardware_concurrency(), 1u);
+	parallelism = (std::min)(parallelism, views.size());
+
+	std::atomic<std::size_t> next{0};
+	const auto worker = [&] {
+		for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < views.size(); i = next.fetch_add(1, std::memory_order_relaxed))
+			results[i] = load_file(views[i]);
+	};
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < parallelism; ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (auto & th : threads)
+		th.join();
+	return results;
+}
+
+//! @brief load_files with std::initializer_list (braced-init-list support)
+inline std::vector<loaded_file> load_files(std::initializer_list<std::string_view> paths, std::size_t parallelism = 0)
+{
+	return load_files<std::initializer_list<std::string_view>>(paths, parallelism);
+}
+
+struct copy_result
+{
+	std::uint64_t bytes{0};
+	std::error_code error;
+
+	explicit operator bool() const { return !error; }
+};
+
+//! @brief copy_file copies src over dst (created or truncated) through file_ptr::copy_to, reporting the bytes copied
+//! @details copying a file onto itself fails with std::errc::invalid_argument and leaves it untouched
+inline copy_result copy_file(const std::string_view & src, const std::string_view & dst)
+{
+	copy_result ret;
+	errno = 0;
+	const file_ptr in(src, "rb");
+	if (!in)
+	{
+		ret.error = details::last_error_or(std::errc::no_such_file_or_directory);
+		return ret;
+	}
+	const auto size = details::stat_size(in.get());
+	if (details::same_file(in.get(), src, dst))
+	{
+		ret.error = std::make_error_code(std::errc::invalid_argument);
+		return ret;
+	}
+	errno = 0;
+	const file_ptr out(dst, "wb");
+	if (!out)
+	{
+		ret.error = details::last_error_or(std::errc::permission_denied);
+		return ret;
+	}
+
+	ret.bytes = in.copy_to(out);
+	out.flush();
+	if (in.error() || out.error() || (size && *size != 0 && ret.bytes != *size))
+		ret.error = std::make_error_code(std::errc::io_error);
+	return ret;
+}
+
+enum class dir_entry_type : std::uint8_t
+{
+	unknown,
+	file,
+	directory,
+	symlink,
+	other,
+};
+
+struct dir_entry
+{
+	//! @brief "<root>/<relative path>", stored in the arena of the owning directory_listing
+	std::string_view path;
+	std::uint64_t size{0};
+	//! @brief last modification, in nanoseconds since the Unix epoch
+	std::int64_t mtime{0};
+	dir_entry_type type{dir_entry_type::unknown};
+};
+
+struct scan_options
+{
+	bool recursive{true};
+	//! @brief report directories as entries too (everything else is always reported)
+	bool include_directories{false};
+	//! @brief stat entries for size and mtime; when off only the type is filled, from d_type where the filesystem has it
+	bool stat_entries{true};
+	//! @brief threads sharing the subdirectories, including the calling one; 0 picks std::thread::hardware_concurrency()
+	std::size_t parallelism{1};
+};
+
+namespace details
+{
+//! @brief bump allocator for strings that must keep a stable address (blocks are never reallocated)
+class string_arena
+{
+public:
+	std::string_view store(std::string_view text)
+	{
+		if (m_blocks_.empty() || m_capacity_ - m_used_ < text.size())
+		{
+			m_capacity_ = (std::max)(block_size, text.size());
+			m_blocks_.emplace_back(new char[m_capacity_]);
+			m_used_ = 0;
+		}
+		char * p = m_blocks_.back().get() + m_used_;
+		if (!text.empty())
+			std::memcpy(p, text.data(), text.size());
+		m_used_ += text.size();
+		return {p, text.size()};
+	}
+
+	//! @brief take over the blocks of other, keeping every view into them valid
+	void splice(string_arena && other)
+	{
+		m_blocks_.insert(m_blocks_.begin(), std::make_move_iterator(other.m_blocks_.begin()), std::make_move_iterator(other.m_blocks_.end()));
+		other.m_blocks_.clear();
+		other.m_used_ = other.m_capacity_ = 0;
+	}
+
+private:
+	static constexpr std::size_t block_size = 64 * 1024;
+	std::vector<std::unique_ptr<char[]>> m_blocks_;
+	std::size_t m_used_{0};
+	std::size_t m_capacity_{0};
+};
+
+//! @brief per-thread output of scan_directory
+struct scan_state
+{
+	string_arena arena;
+	std::vector<dir_entry> entries;
+	std::error_code error;
+	std::string path;
+	std::vector<char> buffer;
+
+	void note(const std::error_code & ec)
+	{
+		if (ec && !error)
+			error = ec;
+	}
+};
+
+inline void join_path(std::string & out, std::string_view dir, std::string_view name)
+{
+	out.assign(dir);
+	if (!out.empty() && out.back() != '/' && out.back() != '\\')
+		out += '/';
+	out += name;
+}
+
+#ifdef _WIN32
+//! @brief list one directory through std::filesystem (FindNextFile already returns size and mtime)
+inline void scan_one_directory(const std::string & dir, const scan_options & options, scan_state & state, std::vector<std::string> & subdirs)
+{
+	std::error_code ec;
+	for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+	{
+		const auto & entry = *it;
+		const auto status = entry.symlink_status(ec);
+		if (ec)
+			break;
+		auto type = dir_entry_type::other;
+		if (std::filesystem::is_regular_file(status))
+			type = dir_entry_type::file;
+		else if (std::filesystem::is_directory(status))
+			type = dir_entry_type::directory;
+		else if (std::filesystem::is_symlink(status))
+			type = dir_entry_type::symlink;
+
+		join_path(state.path, dir, entry.path().filename().string());
+		if (type == dir_entry_type::directory)
+		{
+			if (options.recursive)
+				subdirs.push_back(state.path);
+			if (!options.include_directories)
+				continue;
+		}
+		dir_entry out{state.arena.store(state.path), 0, 0, type};
+		if (options.stat_entries)
+		{
+			std::error_code stat_ec;
+			if (type == dir_entry_type::file)
+				out.size = entry.file_size(stat_ec);
+			const auto time = entry.last_write_time(stat_ec);
+			if (!stat_ec)
+				out.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::file_clock::to_sys(time).time_since_epoch()).count();
+			state.note(stat_ec);
+		}
+		state.entries.push_back(out);
+	}
+	state.note(ec);
+}
+#else
+inline dir_entry_type entry_type_from_mode(mode_t mode)
+{
+	if (S_ISREG(mode))
+		return dir_entry_type::file;
+	if (S_ISDIR(mode))
+		return dir_entry_type::directory;
+	if (S_ISLNK(mode))
+		return dir_entry_type::symlink;
+	return dir_entry_type::other;
+}
+
+inline dir_entry_type entry_type_from_dirent([[maybe_unused]] unsigned char d_type)
+{
+	#ifdef DT_UNKNOWN
+	switch (d_type)
+	{
+	case DT_REG:
+		return dir_entry_type::file;
+	case DT_DIR:
+		return dir_entry_type::directory;
+	case DT_LNK:
+		return dir_entry_type::symlink;
+	case DT_UNKNOWN:
+		return dir_entry_type::unknown;
+	default:
+		return dir_entry_type::other;
+	}
+	#else
+	return dir_entry_type::unknown;
+	#endif
+}
+
+//! @brief handle one name read from the directory open as dfd; stats (relative to dfd) only when d_type or the options need it
+inline void scan_one_entry(int dfd, const std::string & dir, const char * name, unsigned char d_type, const scan_options & options, scan_state & state, std::vector<std::string> & subdirs)
+{
+	if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+		return;
+	auto type = entry_type_from_dirent(d_type);
+	const bool reported = type != dir_entry_type::directory || options.include_directories;
+	struct stat st{};
+	bool have_stat = false;
+	if (type == dir_entry_type::unknown || (options.stat_entries && reported))
+	{
+		if (::fstatat(dfd, name, &st, AT_SYMLINK_NOFOLLOW) != 0)
+		{
+			if (errno != ENOENT) // removed since it was listed
+				state.note({errno, std::generic_category()});
+			return;
+		}
+		have_stat = true;
+		type = entry_type_from_mode(st.st_mode);
+	}
+
+	join_path(state.path, dir, name);
+	if (type == dir_entry_type::directory)
+	{
+		if (options.recursive)
+			subdirs.push_back(state.path);
+		if (!options.include_directories)
+			return;
+	}
+	dir_entry out{state.arena.store(state.path), 0, 0, type};
+	if (have_stat)
+	{
+		#ifdef __APPLE__
+		const auto & mtim = st.st_mtimespec;
+		#else
+		const auto & mtim = st.st_mtim;
+		#endif
+		out.size = type == dir_entry_type::directory ? 0 : static_cast<std::uint64_t>(st.st_size);
+		out.mtime = static_cast<std::int64_t>(mtim.tv_sec) * 1000000000 + mtim.tv_nsec;
+	}
+	state.entries.push_back(out);
+}
+
+//! @brief list one directory: batched getdents64 on Linux, readdir elsewhere
+inline void scan_one_directory(const std::string & dir, const scan_options & options, scan_state & state, std::vector<std::string> & subdirs)
+{
+	const int dfd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (dfd < 0)
+	{
+		state.note({errno, std::generic_category()});
+		return;
+	}
+	#ifdef __linux__
+	if (state.buffer.empty())
+		state.buffer.resize(64 * 1024);
+	for (;;)
+	{
+		const auto n = ::syscall(SYS_getdents64, dfd, state.buffer.data(), state.buffer.size());
+		if (n < 0)
+		{
+			state.note({errno, std::generic_category()});
+			break;
+		}
+		if (n == 0)
+			break;
+		// struct linux_dirent64 { u64 d_ino; s64 d_off; u16 d_reclen; u8 d_type; char d_name[]; }
+		for (long offset = 0; offset < n;)
+		{
+			const char * record = state.buffer.data() + offset;
+			std::uint16_t reclen;
+			std::memcpy(&reclen, record + 16, sizeof(reclen));
+			scan_one_entry(dfd, dir, record + 19, static_cast<unsigned char>(record[18]), options, state, subdirs);
+			offset += reclen;
+		}
+	}
+	::close(dfd);
+	#else
+	DIR * handle = ::fdopendir(dfd);
+	if (!handle)
+	{
+		state.note({errno, std::generic_category()});
+		::close(dfd);
+		return;
+	}
+	while (const auto * entry = ::readdir(handle))
+	{
+		#ifdef DT_UNKNOWN
+		scan_one_entry(dfd, dir, entry->d_name, entry->d_type, options, state, subdirs);
+		#else
+		scan_one_entry(dfd, dir, entry->d_name, 0, options, state, subdirs);
+		#endif
+	}
+	::closedir(handle);
+	#endif
+}
+#endif
+} // namespace details
+
+//! @brief flat result of scan_directory; entry paths point into storage owned by the listing
+class directory_listing
+{
+public:
+	using const_iterator = std::vector<dir_entry>::const_iterator;
+
+	const std::vector<dir_entry> & entries() const { return m_entries_; }
+	const_iterator begin() const { return m_entries_.begin(); }
+	const_iterator end() const { return m_entries_.end(); }
+	std::size_t size() const { return m_entries_.size(); }
+	bool empty() const { return m_entries_.empty(); }
+	const dir_entry & operator[](std::size_t index) const { return m_entries_[index]; }
+
+	//! @brief the first error met; the entries that could be read are still listed
+	std::error_code error() const { return m_error_; }
+	explicit operator bool() const { return !m_error_; }
+
+private:
+	friend directory_listing scan_directory(const std::string_view & root, const scan_options & options);
+
+	details::string_arena m_arena_;
+	std::vector<dir_entry> m_entries_;
+	std::error_code m_error_;
+}; // directory_listing
+
+//! @brief scan_directory lists root (and its subdirectories when recursive) into one flat, arena-backed listing
+//! @note entries come in no particular order; with parallelism > 1 subdirectories are scanned concurrently
+inline directory_listing scan_directory(const std::string_view & root, const scan_options & options = {})
+{
+	auto parallelism = options.parallelism;
+	if (parallelism == 0)
+		parallelism = (std::max)(std::thread::hardware_concurrency(), 1u);
+	if (!options.recursive)
+		parallelism = 1;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::vector<std::string> pending{std::string(root)};
+	std::size_t active = 0;
+	std::vector<details::scan_state> states(parallelism);
+
+	const auto worker = [&](details::scan_state & state) {
+		std::vector<std::string> subdirs;
+		std::unique_lock<std::mutex> lock(mutex);
+		for (;;)
+		{
+			cv.wait(lock, [&] { return !pending.empty() || active == 0; });
+			if (pending.empty())
+				return;
+			const auto dir = std::move(pending.back());
+			pending.pop_back();
+			++active;
+			lock.unlock();
+
+			details::scan_one_directory(dir, options, state, subdirs);
+
+			lock.lock();
+			--active;
+			for (auto & subdir : subdirs)
+				pending.push_back(std::move(subdir));
+			subdirs.clear();
+			cv.notify_all();
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < parallelism; ++i)
+		threads.emplace_back(worker, std::ref(states[i]));
+	worker(states[0]);
+	for (auto & th : threads)
+		th.join();
+
+	directory_listing listing;
+	std::size_t total = 0;
+	for (const auto & state : states)
+		total += state.entries.size();
+	listing.m_entries_.reserve(total);
+	for (auto & state : states)
+	{
+		listing.m_entries_.insert(listing.m_entries_.end(), state.entries.begin(), state.entries.end());
+		listing.m_arena_.splice(std::move(state.arena));
+		if (state.error && !listing.m_error_)
+			listing.m_error_ = state.error;
+	}
+	return listing;
+}
+
+} // namespace msl
+#endif // MSL_FS_H__
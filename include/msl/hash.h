@@ -0,0 +1,278 @@
+#ifndef MSL_HASH_H__
+#define MSL_HASH_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef MSL_SIMD_X86
+#include <nmmintrin.h>
+#endif
+
+namespace msl
+{
+
+namespace details
+{
+inline std::uint32_t load_le32(const unsigned char * p) noexcept
+{
+	return std::uint32_t{p[0]} | std::uint32_t{p[1]} << 8 | std::uint32_t{p[2]} << 16 | std::uint32_t{p[3]} << 24;
+}
+
+inline std::uint64_t load_le64(const unsigned char * p) noexcept
+{
+	return std::uint64_t{load_le32(p)} | std::uint64_t{load_le32(p + 4)} << 32;
+}
+
+constexpr std::array<std::array<std::uint32_t, 256>, 8> make_crc32c_tables()
+{
+	std::array<std::array<std::uint32_t, 256>, 8> tables{};
+	for (std::uint32_t i = 0; i < 256; ++i)
+	{
+		std::uint32_t crc = i;
+		for (int bit = 0; bit < 8; ++bit)
+			crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+		tables[0][i] = crc;
+	}
+	for (std::size_t k = 1; k < 8; ++k)
+	{
+		for (std::size_t i = 0; i < 256; ++i)
+			tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+	}
+	return tables;
+}
+
+inline constexpr auto crc32c_tables = make_crc32c_tables();
+
+//! @brief slice-by-8 CRC-32C on raw (non-inverted) state
+inline std::uint32_t crc32c_software(std::uint32_t crc, const unsigned char * p, std::size_t n) noexcept
+{
+	const auto & t = crc32c_tables;
+	for (; n >= 8; p += 8, n -= 8)
+	{
+		const auto one = load_le32(p) ^ crc;
+		const auto two = load_le32(p + 4);
+		crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+			t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+	}
+	for (; n != 0; ++p, --n)
+		crc = t[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+	return crc;
+}
+
+#ifdef MSL_SIMD_X86
+//! @brief CRC-32C through the SSE4.2 crc32 instruction (8 bytes per step on x64)
+MSL_SIMD_TARGET("sse4.2") inline std::uint32_t crc32c_sse42(std::uint32_t crc, const unsigned char * p, std::size_t n) noexcept
+{
+	#if defined(__x86_64__) || defined(_M_X64)
+	std::uint64_t crc64 = crc;
+	for (; n >= 8; p += 8, n -= 8)
+	{
+		std::uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		crc64 = _mm_crc32_u64(crc64, word);
+	}
+	crc = static_cast<std::uint32_t>(crc64);
+	#endif
+	for (; n >= 4; p += 4, n -= 4)
+	{
+		std::uint32_t word;
+		std::memcpy(&word, p, sizeof(word));
+		crc = _mm_crc32_u32(crc, word);
+	}
+	for (; n != 0; ++p, --n)
+		crc = _mm_crc32_u8(crc, *p);
+	return crc;
+}
+#endif
+} // namespace details
+
+//! @brief streaming CRC-32C (Castagnoli): SSE4.2 when the CPU has it, slice-by-8 tables otherwise
+class crc32c
+{
+public:
+	using value_type = std::uint32_t;
+
+	crc32c & update(std::span<const std::byte> data) noexcept
+	{
+		const auto p = reinterpret_cast<const unsigned char *>(data.data());
+		#ifdef MSL_SIMD_X86
+		if (simd::cpu().sse42)
+		{
+			m_state_ = details::crc32c_sse42(m_state_, p, data.size());
+			return *this;
+		}
+		#endif
+		m_state_ = details::crc32c_software(m_state_, p, data.size());
+		return *this;
+	}
+	crc32c & update(std::string_view data) noexcept { return update(std::as_bytes(std::span(data))); }
+
+	value_type finish() const noexcept { return ~m_state_; }
+	void reset() noexcept { m_state_ = 0xFFFFFFFFu; }
+
+	//! @brief one-shot helper
+	static value_type hash(std::span<const std::byte> data) noexcept { return crc32c().update(data).finish(); }
+	static value_type hash(std::string_view data) noexcept { return crc32c().update(data).finish(); }
+
+private:
+	std::uint32_t m_state_{0xFFFFFFFFu};
+}; // crc32c
+
+//! @brief streaming XXH64: four independent lanes over 32-byte stripes, bit-compatible with the reference
+class xxhash64
+{
+public:
+	using value_type = std::uint64_t;
+
+	xxhash64() noexcept { reset(); }
+	explicit xxhash64(std::uint64_t seed) noexcept { reset(seed); }
+
+	xxhash64 & update(std::span<const std::byte> data) noexcept
+	{
+		auto p = reinterpret_cast<const unsigned char *>(data.data());
+		auto n = data.size();
+		m_total_ += n;
+		if (m_buffered_ != 0)
+		{
+			const auto take = (std::min)(n, m_buffer_.size() - m_buffered_);
+			std::memcpy(m_buffer_.data() + m_buffered_, p, take);
+			m_buffered_ += take;
+			p += take;
+			n -= take;
+			if (m_buffered_ < m_buffer_.size())
+				return *this;
+			consume(m_buffer_.data());
+			m_buffered_ = 0;
+		}
+		for (; n >= 32; p += 32, n -= 32)
+			consume(p);
+		if (n != 0)
+		{
+			std::memcpy(m_buffer_.data(), p, n);
+			m_buffered_ = n;
+		}
+		return *this;
+	}
+	xxhash64 & update(std::string_view data) noexcept { return update(std::as_bytes(std::span(data))); }
+
+	value_type finish() const noexcept
+	{
+		std::uint64_t h;
+		if (m_total_ >= 32)
+		{
+			h = std::rotl(m_lanes_[0], 1) + std::rotl(m_lanes_[1], 7) + std::rotl(m_lanes_[2], 12) + std::rotl(m_lanes_[3], 18);
+			for (const auto lane : m_lanes_)
+				h = (h ^ round(0, lane)) * p1 + p4;
+		}
+		else
+			h = m_seed_ + p5;
+		h += m_total_;
+
+		const unsigned char * p = m_buffer_.data();
+		auto n = m_buffered_;
+		for (; n >= 8; p += 8, n -= 8)
+			h = std::rotl(h ^ round(0, details::load_le64(p)), 27) * p1 + p4;
+		if (n >= 4)
+		{
+			h = std::rotl(h ^ (std::uint64_t{details::load_le32(p)} * p1), 23) * p2 + p3;
+			p += 4;
+			n -= 4;
+		}
+		for (; n != 0; ++p, --n)
+			h = std::rotl(h ^ (*p * p5), 11) * p1;
+
+		h ^= h >> 33;
+		h *= p2;
+		h ^= h >> 29;
+		h *= p3;
+		h ^= h >> 32;
+		return h;
+	}
+
+	void reset(std::uint64_t seed = 0) noexcept
+	{
+		m_seed_ = seed;
+		m_lanes_ = {seed + p1 + p2, seed + p2, seed, seed - p1};
+		m_total_ = 0;
+		m_buffered_ = 0;
+	}
+
+	//! @brief one-shot helper
+	static value_type hash(std::span<const std::byte> data, std::uint64_t seed = 0) noexcept { return xxhash64(seed).update(data).finish(); }
+	static value_type hash(std::string_view data, std::uint64_t seed = 0) noexcept { return xxhash64(seed).update(data).finish(); }
+
+private:
+	static constexpr std::uint64_t p1 = 0x9E3779B185EBCA87ULL;
+	static constexpr std::uint64_t p2 = 0xC2B2AE3D27D4EB4FULL;
+	static constexpr std::uint64_t p3 = 0x165667B19E3779F9ULL;
+	static constexpr std::uint64_t p4 = 0x85EBCA77C2B2AE63ULL;
+	static constexpr std::uint64_t p5 = 0x27D4EB2F165667C5ULL;
+
+	static std::uint64_t round(std::uint64_t acc, std::uint64_t input) noexcept { return std::rotl(acc + input * p2, 31) * p1; }
+
+	void consume(const unsigned char * stripe) noexcept
+	{
+		for (std::size_t i = 0; i < 4; ++i)
+			m_lanes_[i] = round(m_lanes_[i], details::load_le64(stripe + i * 8));
+	}
+
+	std::uint64_t m_seed_{0};
+	std::array<std::uint64_t, 4> m_lanes_{};
+	std::uint64_t m_total_{0};
+	std::array<unsigned char, 32> m_buffer_{};
+	std::size_t m_buffered_{0};
+}; // xxhash64
+
+//! @brief hash_file feeds the file from its current position to EOF into hasher in chunk_size reads
+//! @return the digest, or nullopt on a read error
+template <typename Hasher>
+std::optional<typename Hasher::value_type> hash_file(const file_ptr & file, Hasher hasher = {}, std::size_t chunk_size = 1 << 20)
+{
+	if (!file)
+		return std::nullopt;
+	std::vector<std::byte> buffer((std::max)(chunk_size, std::size_t{1}));
+	while (const auto n = file.fread(buffer.data(), buffer.size()))
+		hasher.update(std::span<const std::byte>(buffer.data(), n));
+	if (file.error())
+		return std::nullopt;
+	return hasher.finish();
+}
+
+//! @brief hash_file for a path opened in binary mode
+template <typename Hasher>
+std::optional<typename Hasher::value_type> hash_file(const std::string_view & path, Hasher hasher = {}, std::size_t chunk_size = 1 << 20)
+{
+	const file_ptr file(path, "rb");
+	return hash_file(file, std::move(hasher), chunk_size);
+}
+
+} // namespace msl
+#endif // MSL_HASH_H__
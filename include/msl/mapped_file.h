@@ -0,0 +1,151 @@
+#ifndef MSL_MAPPED_FILE_H__
+#define MSL_MAPPED_FILE_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "fs.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace msl
+{
+
+//! @brief read-only view of a whole file: mmap on POSIX, a loaded buffer elsewhere
+class mapped_file
+{
+public:
+	mapped_file() = default;
+	explicit mapped_file(const std::string_view & path) { open(path); }
+
+	mapped_file(mapped_file && other) noexcept { *this = std::move(other); }
+	mapped_file & operator=(mapped_file && other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			m_data_ = std::exchange(other.m_data_, nullptr);
+			m_size_ = std::exchange(other.m_size_, 0);
+			m_mapped_ = std::exchange(other.m_mapped_, false);
+			m_open_ = std::exchange(other.m_open_, false);
+			m_buffer_ = std::move(other.m_buffer_);
+			m_error_ = std::exchange(other.m_error_, {});
+			if (!m_mapped_)
+				m_data_ = m_buffer_.data();
+		}
+		return *this;
+	}
+	mapped_file(const mapped_file &) = delete;
+	mapped_file & operator=(const mapped_file &) = delete;
+	~mapped_file() { reset(); }
+
+	//! @brief map the file, closing any previous mapping; check error() on failure
+	bool open(const std::string_view & path)
+	{
+		reset();
+		#ifndef _WIN32
+		const std::string path_str(path);
+		const int fd = ::open(path_str.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+		{
+			m_error_ = {errno, std::generic_category()};
+			return false;
+		}
+		struct stat st;
+		if (::fstat(fd, &st) != 0)
+		{
+			m_error_ = {errno, std::generic_category()};
+			::close(fd);
+			return false;
+		}
+		if (st.st_size > 0)
+		{
+			void * ptr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (ptr != MAP_FAILED)
+			{
+				m_data_ = static_cast<const char *>(ptr);
+				m_size_ = static_cast<std::size_t>(st.st_size);
+				m_mapped_ = true;
+				m_open_ = true;
+				::close(fd);
+				return true;
+			}
+		}
+		::close(fd); // empty or unmappable (pipes, procfs): fall back to reading
+		#endif
+		auto loaded = load_file(path);
+		if (loaded.error)
+		{
+			m_error_ = loaded.error;
+			return false;
+		}
+		m_buffer_ = std::move(loaded.data);
+		m_data_ = m_buffer_.data();
+		m_size_ = m_buffer_.size();
+		m_open_ = true;
+		return true;
+	}
+
+	//! @brief unmap (or free) the contents
+	void reset()
+	{
+		#ifndef _WIN32
+		if (m_mapped_)
+			::munmap(const_cast<char *>(m_data_), m_size_);
+		#endif
+		m_data_ = nullptr;
+		m_size_ = 0;
+		m_mapped_ = false;
+		m_open_ = false;
+		m_buffer_ = {};
+		m_error_ = {};
+	}
+
+	bool is_open() const { return m_open_; }
+	explicit operator bool() const { return m_open_; }
+	//! @brief true if the contents are memory mapped rather than copied
+	bool is_mapped() const { return m_mapped_; }
+	std::error_code error() const { return m_error_; }
+
+	const char * data() const { return m_data_; }
+	std::size_t size() const { return m_size_; }
+	std::string_view view() const { return {m_data_, m_size_}; }
+	std::span<const std::byte> bytes() const { return {reinterpret_cast<const std::byte *>(m_data_), m_size_}; }
+
+private:
+	const char * m_data_{nullptr};
+	std::size_t m_size_{0};
+	bool m_mapped_{false};
+	bool m_open_{false};
+	std::vector<char> m_buffer_;
+	std::error_code m_error_;
+}; // mapped_file
+
+} // namespace msl
+#endif // MSL_MAPPED_FILE_H__
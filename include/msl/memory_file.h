@@ -0,0 +1,249 @@
+#ifndef MSL_MEMORY_FILE_H__
+#define MSL_MEMORY_FILE_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+#define MSL_MEMORY_FILE_HAS_MEMFD
+#endif
+
+namespace msl
+{
+
+struct memory_file_options
+{
+	//! @brief capacity of the fmemopen fallback buffer; memfd-backed files grow freely
+	std::size_t fallback_capacity{std::size_t{1} << 20};
+	//! @brief create the memfd with MFD_ALLOW_SEALING so that seal() can freeze it
+	bool allow_sealing{false};
+};
+
+//! @brief anonymous in-memory file behind a regular file_ptr: memfd_create on Linux, fmemopen elsewhere
+//! @note Windows has neither and falls back to std::tmpfile(), whose view() is a copy
+class memory_file
+{
+public:
+	explicit memory_file(const std::string_view & name = "msl", const memory_file_options & options = {}) { open(name, options); }
+
+	//! @note moving keeps the fmemopen buffer in place: the vector's storage is transferred, not reallocated
+	memory_file(memory_file && other) noexcept { *this = std::move(other); }
+	memory_file & operator=(memory_file && other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			m_file_ = std::move(other.m_file_);
+			m_buffer_ = std::move(other.m_buffer_);
+			other.m_buffer_.clear();
+			m_map_ = std::exchange(other.m_map_, nullptr);
+			m_map_size_ = std::exchange(other.m_map_size_, 0);
+			m_memfd_ = std::exchange(other.m_memfd_, false);
+			m_sealed_ = std::exchange(other.m_sealed_, false);
+			m_error_ = std::exchange(other.m_error_, {});
+		}
+		return *this;
+	}
+	memory_file(const memory_file &) = delete;
+	memory_file & operator=(const memory_file &) = delete;
+	~memory_file() { reset(); }
+
+	//! @brief create a new empty file, closing any previous one; check error() on failure
+	bool open(const std::string_view & name = "msl", const memory_file_options & options = {})
+	{
+		reset();
+		#ifdef MSL_MEMORY_FILE_HAS_MEMFD
+		const std::string name_str(name);
+		const int fd = ::memfd_create(name_str.c_str(), MFD_CLOEXEC | (options.allow_sealing ? MFD_ALLOW_SEALING : 0u));
+		if (fd >= 0)
+		{
+			if (auto * fp = ::fdopen(fd, "w+b"))
+			{
+				m_file_ = file_ptr(fp);
+				m_memfd_ = true;
+				return true;
+			}
+			m_error_ = {errno, std::generic_category()};
+			::close(fd);
+			return false;
+		}
+		if (errno != ENOSYS)
+		{
+			m_error_ = {errno, std::generic_category()};
+			return false;
+		}
+		#else
+		(void)name;
+		#endif
+
+		errno = 0;
+		#ifdef _WIN32
+		(void)options;
+		m_file_ = file_ptr(std::tmpfile());
+		#else
+		m_buffer_.resize((std::max)(options.fallback_capacity, std::size_t{1}));
+		m_file_ = file_ptr(::fmemopen(m_buffer_.data(), m_buffer_.size(), "w+b"));
+		#endif
+		if (!m_file_)
+		{
+			m_error_ = errno != 0 ? std::error_code(errno, std::generic_category()) : std::make_error_code(std::errc::not_enough_memory);
+			m_buffer_.clear();
+			return false;
+		}
+		return true;
+	}
+
+	//! @brief close the file and release its memory (any view() becomes dangling)
+	void reset()
+	{
+		unmap();
+		m_file_.close();
+		m_buffer_.clear();
+		m_buffer_.shrink_to_fit();
+		m_memfd_ = false;
+		m_sealed_ = false;
+		m_error_ = {};
+	}
+
+	//! @brief the file, with the whole file_ptr API
+	file_ptr & file() { return m_file_; }
+	const file_ptr & file() const { return m_file_; }
+
+	bool is_open() const { return static_cast<bool>(m_file_); }
+	explicit operator bool() const { return is_open(); }
+	//! @brief true if backed by memfd_create (sealable, unbounded, shareable by descriptor)
+	bool is_memfd() const { return m_memfd_; }
+	bool is_sealed() const { return m_sealed_; }
+	std::error_code error() const { return m_error_; }
+
+	//! @brief size of the contents after flushing pending writes
+	std::size_t size()
+	{
+		if (!m_file_)
+			return 0;
+		m_file_.flush();
+		#ifdef MSL_MEMORY_FILE_HAS_MEMFD
+		if (m_memfd_)
+		{
+			struct stat st{};
+			return ::fstat(::fileno(m_file_.get()), &st) == 0 ? static_cast<std::size_t>(st.st_size) : 0;
+		}
+		#endif
+		return m_file_.size();
+	}
+
+	//! @brief flush pending writes and view the whole contents without copying them
+	//! @note the span stays valid until the file grows or shrinks, is reset, or view() is called after such a change
+	std::span<const std::byte> view()
+	{
+		const auto n = size();
+		if (n == 0)
+			return {};
+		#ifdef MSL_MEMORY_FILE_HAS_MEMFD
+		if (m_memfd_)
+		{
+			if (n != m_map_size_)
+			{
+				unmap();
+				// a private read-only mapping keeps the file sealable (F_SEAL_WRITE refuses shared writable mappings)
+				void * addr = ::mmap(nullptr, n, PROT_READ, MAP_PRIVATE, ::fileno(m_file_.get()), 0);
+				if (addr == MAP_FAILED)
+				{
+					m_error_ = {errno, std::generic_category()};
+					return {};
+				}
+				m_map_ = addr;
+				m_map_size_ = n;
+			}
+			return {static_cast<const std::byte *>(m_map_), m_map_size_};
+		}
+		#endif
+		#ifdef _WIN32
+		const auto pos = m_file_.tell();
+		m_buffer_.resize(n);
+		m_file_.seek(0);
+		m_buffer_.resize(m_file_.fread(m_buffer_.data(), n));
+		m_file_.seek(static_cast<long>(pos));
+		#endif
+		return {reinterpret_cast<const std::byte *>(m_buffer_.data()), (std::min)(n, m_buffer_.size())};
+	}
+
+	//! @brief view() as characters
+	std::string_view str()
+	{
+		const auto bytes = view();
+		return {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+	}
+
+	//! @brief flush and forbid any further write, resize or seal (F_SEAL_WRITE | F_SEAL_GROW | F_SEAL_SHRINK | F_SEAL_SEAL)
+	//! @note needs a memfd opened with allow_sealing; other backends return operation_not_supported
+	std::error_code seal()
+	{
+		#if defined(MSL_MEMORY_FILE_HAS_MEMFD) && defined(F_ADD_SEALS)
+		if (m_memfd_)
+		{
+			m_file_.flush();
+			if (::fcntl(::fileno(m_file_.get()), F_ADD_SEALS, F_SEAL_WRITE | F_SEAL_GROW | F_SEAL_SHRINK | F_SEAL_SEAL) != 0)
+				return {errno, std::generic_category()};
+			m_sealed_ = true;
+			return {};
+		}
+		#endif
+		return std::make_error_code(std::errc::operation_not_supported);
+	}
+
+private:
+	void unmap()
+	{
+		#ifdef MSL_MEMORY_FILE_HAS_MEMFD
+		if (m_map_)
+			::munmap(m_map_, m_map_size_);
+		#endif
+		m_map_ = nullptr;
+		m_map_size_ = 0;
+	}
+
+	file_ptr m_file_;
+	std::vector<char> m_buffer_;
+	void * m_map_{nullptr};
+	std::size_t m_map_size_{0};
+	bool m_memfd_{false};
+	bool m_sealed_{false};
+	std::error_code m_error_;
+}; // memory_file
+
+} // namespace msl
+#endif // MSL_MEMORY_FILE_H__
@@ -17,16 +17,36 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "async_file.h"
+#include "async_log.h"
+#include "atomic_writer.h"
 #include "bench.h"
 #include "cast.h"
 #include "assert.h"
+#include "compress.h"
+#include "direct_file.h"
+#include "endian.h"
+#include "fd_file.h"
 #include "file_ptr.h"
+#include "file_watcher.h"
+#include "fs.h"
+#include "hash.h"
 #include "macro.h"
+#include "mapped_file.h"
+#include "memory_file.h"
+#include "multi_pattern.h"
+#include "parallel_lines.h"
 #include "pool.h"
+#include "prefetch.h"
 #include "ptr.h"
 #include "random.h"
 #include "range.h"
+#include "rolling_file.h"
+#include "simd.h"
+#include "table_cache.h"
 #include "traits.h"
+#include "tsv.h"
+#include "utf8.h"
 #include "utils.h"
 
 #endif // MSL_MSL_H__
@@ -0,0 +1,298 @@
+#ifndef MSL_MULTI_PATTERN_H__
+#define MSL_MULTI_PATTERN_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace msl
+{
+
+struct multi_pattern_options
+{
+	//! @brief match ASCII letters regardless of case (other bytes compare exactly)
+	bool ignore_case{false};
+};
+
+//! @brief one occurrence of a pattern: text[position, position + length) matched patterns[pattern]
+struct pattern_match
+{
+	std::size_t position{0};
+	std::size_t length{0};
+	std::size_t pattern{0};
+
+	bool operator==(const pattern_match &) const = default;
+};
+
+//! @brief multi_pattern is an Aho-Corasick automaton compiled once from a word list and scanned in one pass per text
+//! @note the goto function is a full DFA over the byte classes used by the patterns, so a scan costs one table lookup
+//! per byte whatever the number of patterns; empty patterns are ignored and duplicates keep their first index
+class multi_pattern
+{
+public:
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	multi_pattern() { compile(std::initializer_list<std::string_view>{}); }
+	template <std::ranges::input_range R>
+		requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+	explicit multi_pattern(const R & patterns, const multi_pattern_options & options = {}) : m_options_(options)
+	{
+		std::vector<std::string_view> views;
+		for (auto && pattern : patterns)
+			views.emplace_back(pattern);
+		compile(views);
+	}
+	multi_pattern(std::initializer_list<std::string_view> patterns, const multi_pattern_options & options = {})
+		: m_options_(options)
+	{
+		compile(patterns);
+	}
+
+	//! @brief number of patterns the automaton was built from (the pattern indices of the matches)
+	std::size_t size() const noexcept { return m_patterns_; }
+	bool empty() const noexcept { return m_patterns_ == 0; }
+	bool ignore_case() const noexcept { return m_options_.ignore_case; }
+
+	//! @brief call fn(pattern_match) for every occurrence, overlapping ones included, ordered by end position
+	template <typename Fn> void for_each_match(std::string_view text, Fn && fn) const
+	{
+		std::uint32_t state = 0;
+		for (std::size_t i = 0; i < text.size(); ++i)
+		{
+			state = step(state, text[i]);
+			for (auto node = m_out_[state]; node != none; node = m_out_[m_fail_[node]])
+				fn(pattern_match{i + 1 - m_depth_[node], m_depth_[node], m_pattern_[node]});
+		}
+	}
+
+	//! @brief every occurrence, overlapping ones included, ordered by end position
+	std::vector<pattern_match> find_all(std::string_view text) const
+	{
+		std::vector<pattern_match> matches;
+		for_each_match(text, [&matches](const pattern_match & match) { matches.push_back(match); });
+		return matches;
+	}
+
+	//! @brief true if any pattern occurs in text, stopping at the first occurrence
+	bool contains_any(std::string_view text) const noexcept
+	{
+		std::uint32_t state = 0;
+		for (const auto ch : text)
+		{
+			state = step(state, ch);
+			if (m_out_[state] != none)
+				return true;
+		}
+		return false;
+	}
+
+	//! @brief leftmost occurrence at or after pos (the longest one among those starting there); position is npos if none
+	pattern_match find_first(std::string_view text, std::size_t pos = 0) const noexcept
+	{
+		pattern_match best{npos, 0, npos};
+		std::uint32_t state = 0;
+		for (std::size_t i = pos; i < text.size(); ++i)
+		{
+			state = step(state, text[i]);
+			const auto node = m_out_[state];
+			if (node != none)
+			{
+				const auto start = i + 1 - m_depth_[node];
+				if (best.position == npos || start < best.position || (start == best.position && m_depth_[node] > best.length))
+					best = {start, m_depth_[node], m_pattern_[node]};
+			}
+			// no partial match still in progress can start at or before the best one
+			if (best.position != npos && i + 1 - m_depth_[state] > best.position)
+				break;
+		}
+		return best;
+	}
+
+	//! @brief write text into out with every leftmost-longest, non-overlapping occurrence replaced by
+	//! replacements[pattern]; patterns without a replacement are kept as they are
+	//! @note out is overwritten and must not alias text; after each match the scan restarts at its end, so bytes read past
+	//! it are read again (at most the longest pattern per match)
+	//! @return the number of replacements
+	std::size_t replace_into(std::string & out, std::string_view text, std::span<const std::string_view> replacements) const
+	{
+		return replace(out, text, [&replacements](std::size_t pattern, std::string_view & with) {
+			if (pattern >= replacements.size())
+				return false;
+			with = replacements[pattern];
+			return true;
+		});
+	}
+
+	//! @brief replace_into with the same replacement for every pattern (e.g. "***" for a chat filter)
+	std::size_t replace_into(std::string & out, std::string_view text, std::string_view replacement) const
+	{
+		return replace(out, text, [replacement](std::size_t, std::string_view & with) {
+			with = replacement;
+			return true;
+		});
+	}
+
+	//! @brief replace_into a new string
+	std::string replace_all(std::string_view text, std::span<const std::string_view> replacements) const
+	{
+		std::string out;
+		replace_into(out, text, replacements);
+		return out;
+	}
+	std::string replace_all(std::string_view text, std::string_view replacement) const
+	{
+		std::string out;
+		replace_into(out, text, replacement);
+		return out;
+	}
+
+private:
+	static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+	std::uint32_t step(std::uint32_t state, char ch) const noexcept
+	{
+		return m_goto_[static_cast<std::size_t>(state) * m_classes_ + m_class_[static_cast<unsigned char>(ch)]];
+	}
+
+	static unsigned char fold(unsigned char c) noexcept { return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c; }
+
+	template <typename Lookup> std::size_t replace(std::string & out, std::string_view text, Lookup && lookup) const
+	{
+		out.clear();
+		out.reserve(text.size());
+		std::size_t count = 0;
+		std::size_t pos = 0;
+		while (pos < text.size())
+		{
+			const auto match = find_first(text, pos);
+			if (match.position == npos)
+				break;
+			std::string_view with;
+			if (lookup(match.pattern, with))
+			{
+				out.append(text.substr(pos, match.position - pos));
+				out.append(with);
+				++count;
+			}
+			else
+				out.append(text.substr(pos, match.position + match.length - pos));
+			pos = match.position + match.length;
+		}
+		out.append(text.substr((std::min)(pos, text.size())));
+		return count;
+	}
+
+	template <typename Patterns> void compile(const Patterns & patterns)
+	{
+		// byte classes: 0 for bytes in no pattern, one class per distinct (case-folded) byte otherwise
+		m_class_.fill(0);
+		m_classes_ = 1;
+		for (const std::string_view pattern : patterns)
+		{
+			for (const auto ch : pattern)
+			{
+				const auto c = m_options_.ignore_case ? fold(static_cast<unsigned char>(ch)) : static_cast<unsigned char>(ch);
+				if (m_class_[c] == 0)
+					m_class_[c] = static_cast<std::uint16_t>(m_classes_++);
+			}
+		}
+		if (m_options_.ignore_case)
+		{
+			for (unsigned c = 'A'; c <= 'Z'; ++c)
+				m_class_[c] = m_class_[c + ('a' - 'A')];
+		}
+
+		m_goto_.assign(m_classes_, 0);
+		m_depth_.assign(1, 0);
+		m_pattern_.assign(1, none);
+		m_patterns_ = 0;
+		for (const std::string_view pattern : patterns)
+		{
+			const auto index = static_cast<std::uint32_t>(m_patterns_++);
+			if (pattern.empty())
+				continue;
+			std::uint32_t node = 0;
+			for (const auto ch : pattern)
+			{
+				auto & next = m_goto_[static_cast<std::size_t>(node) * m_classes_ + m_class_[static_cast<unsigned char>(ch)]];
+				if (next == 0)
+				{
+					next = static_cast<std::uint32_t>(m_depth_.size());
+					m_depth_.push_back(m_depth_[node] + 1);
+					m_pattern_.push_back(none);
+					m_goto_.resize(m_goto_.size() + m_classes_, 0);
+				}
+				node = m_goto_[static_cast<std::size_t>(node) * m_classes_ + m_class_[static_cast<unsigned char>(ch)]];
+			}
+			if (m_pattern_[node] == none)
+				m_pattern_[node] = index;
+		}
+
+		// breadth-first failure links; missing transitions are filled from the failure state to complete the DFA
+		const auto nodes = m_depth_.size();
+		m_fail_.assign(nodes, 0);
+		m_out_.assign(nodes, none);
+		std::vector<std::uint32_t> queue;
+		queue.reserve(nodes);
+		queue.push_back(0);
+		for (std::size_t head = 0; head < queue.size(); ++head)
+		{
+			const auto node = queue[head];
+			const auto row = static_cast<std::size_t>(node) * m_classes_;
+			const auto fail_row = static_cast<std::size_t>(m_fail_[node]) * m_classes_;
+			// rows are completed in breadth-first order, so a non-zero entry here is still a trie edge; class 0 always
+			// resets to the root
+			for (std::size_t c = 1; c < m_classes_; ++c)
+			{
+				const auto child = m_goto_[row + c];
+				if (child == 0)
+				{
+					if (node != 0)
+						m_goto_[row + c] = m_goto_[fail_row + c];
+					continue;
+				}
+				m_fail_[child] = node == 0 ? 0 : m_goto_[fail_row + c];
+				m_out_[child] = m_pattern_[child] != none ? child : m_out_[m_fail_[child]];
+				queue.push_back(child);
+			}
+		}
+	}
+
+	multi_pattern_options m_options_;
+	std::array<std::uint16_t, 256> m_class_{};
+	std::size_t m_classes_{1};
+	std::size_t m_patterns_{0};
+	std::vector<std::uint32_t> m_goto_;
+	std::vector<std::uint32_t> m_fail_;
+	std::vector<std::uint32_t> m_out_;
+	std::vector<std::uint32_t> m_depth_;
+	std::vector<std::uint32_t> m_pattern_;
+}; // multi_pattern
+
+} // namespace msl
+#endif // MSL_MULTI_PATTERN_H__
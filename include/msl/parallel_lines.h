@@ -0,0 +1,96 @@
+#ifndef MSL_PARALLEL_LINES_H__
+#define MSL_PARALLEL_LINES_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "mapped_file.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace msl
+{
+
+namespace details
+{
+//! @brief call map_fn(acc, line) for every line of a chunk, without the '\n' or "\r\n" terminator
+template <typename Accumulator, typename Map> void map_lines(std::string_view chunk, Accumulator & acc, Map & map_fn)
+{
+	while (!chunk.empty())
+	{
+		const auto newline = chunk.find('\n');
+		auto line = chunk.substr(0, newline);
+		chunk.remove_prefix(newline == std::string_view::npos ? chunk.size() : newline + 1);
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+		map_fn(acc, line);
+	}
+}
+
+//! @brief split text into newline-aligned chunks, map them concurrently and reduce the partial accumulators in order
+template <typename Accumulator, typename Map, typename Reduce>
+Accumulator parallel_lines(std::string_view text, Map & map_fn, Reduce & reduce_fn, std::size_t threads)
+{
+	if (threads == 0)
+		threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+	const auto chunks = line_chunks(text, threads);
+	std::vector<Accumulator> parts(chunks.size());
+	const auto work = [&](std::size_t index) { map_lines(chunks[index], parts[index], map_fn); };
+
+	std::vector<std::thread> workers;
+	for (std::size_t i = 1; i < chunks.size(); ++i)
+		workers.emplace_back(work, i);
+	if (!chunks.empty())
+		work(0);
+	for (auto & th : workers)
+		th.join();
+
+	Accumulator total{};
+	for (auto & part : parts)
+		reduce_fn(total, std::move(part));
+	return total;
+}
+} // namespace details
+
+//! @brief parallel_lines maps the lines of a mapped file concurrently, one newline-aligned chunk per thread
+//! @note every chunk gets its own default-constructed Accumulator, filled by map_fn(acc, line) on a worker thread
+//! with zero-copy std::string_view lines; the parts are then merged in file order by reduce_fn(total, std::move(part))
+template <typename Accumulator, typename Map, typename Reduce>
+Accumulator parallel_lines(const mapped_file & file, Map && map_fn, Reduce && reduce_fn, std::size_t threads = 0)
+{
+	return details::parallel_lines<Accumulator>(file.view(), map_fn, reduce_fn, threads);
+}
+
+//! @brief parallel_lines over a file mapped for the duration of the call
+//! @return the merged accumulator, or nullopt if the file cannot be opened
+template <typename Accumulator, typename Map, typename Reduce>
+std::optional<Accumulator> parallel_lines(const std::string_view & path, Map && map_fn, Reduce && reduce_fn, std::size_t threads = 0)
+{
+	const mapped_file file(path);
+	if (!file)
+		return std::nullopt;
+	return details::parallel_lines<Accumulator>(file.view(), map_fn, reduce_fn, threads);
+}
+
+} // namespace msl
+#endif // MSL_PARALLEL_LINES_H__
@@ -0,0 +1,257 @@
+#ifndef MSL_PREFETCH_H__
+#define MSL_PREFETCH_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) || defined(__FreeBSD__)
+#include <fcntl.h>
+#endif
+
+namespace msl
+{
+
+struct prefetch_options
+{
+	std::size_t buffer_size{1 << 20}; // bytes read by the helper thread per request
+	std::size_t buffer_count{2}; // 2 = double buffering, more = deeper read-ahead
+};
+
+//! @brief sequential reader that fills the next buffers on a helper thread while the caller consumes the current one
+//! @note the reader owns the file_ptr and reads from its current position; only the helper thread touches it
+class prefetching_reader
+{
+public:
+	explicit prefetching_reader(file_ptr file, prefetch_options options = {}) : m_file_(std::move(file)), m_options_(options)
+	{
+		m_options_.buffer_size = (std::max)(m_options_.buffer_size, std::size_t{1});
+		m_options_.buffer_count = (std::max)(m_options_.buffer_count, std::size_t{1});
+		if (!m_file_)
+			return;
+		m_buffers_.resize(m_options_.buffer_count);
+		m_sizes_.resize(m_options_.buffer_count);
+		for (auto & buf : m_buffers_)
+			buf.reset(new char[m_options_.buffer_size]);
+		advise_sequential();
+		m_thread_ = std::thread([this] { run(); });
+	}
+	explicit prefetching_reader(const std::string_view & filename, prefetch_options options = {}) :
+		prefetching_reader(file_ptr(filename, "rb"), options)
+	{
+	}
+
+	prefetching_reader(const prefetching_reader &) = delete;
+	prefetching_reader & operator=(const prefetching_reader &) = delete;
+
+	~prefetching_reader()
+	{
+		if (!m_thread_.joinable())
+			return;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex_);
+			m_stop_ = true;
+		}
+		m_cv_.notify_all();
+		m_thread_.join();
+	}
+
+	bool is_open() const { return m_file_.is_open(); }
+
+	//! @brief read up to n bytes into buf; returns bytes read (short only at EOF or on error)
+	std::size_t read(void * buf, std::size_t n)
+	{
+		auto * out = static_cast<char *>(buf);
+		std::size_t got = 0;
+		while (got < n && fill_current())
+		{
+			const auto count = (std::min)(n - got, m_current_size_ - m_pos_);
+			std::memcpy(out + got, m_current_ + m_pos_, count);
+			m_pos_ += count;
+			got += count;
+		}
+		m_consumed_bytes_ += got;
+		return got;
+	}
+
+	//! @brief read into the span returning the elements read, as file_ptr::read(std::span<T>) does
+	template <typename T> std::size_t read(std::span<T> buffer) { return read(buffer.data(), buffer.size_bytes()) / sizeof(T); }
+
+	//! @brief read up to n bytes returning a vector
+	std::vector<char> read(std::size_t n)
+	{
+		std::vector<char> buf(n);
+		buf.resize(read(buf.data(), buf.size()));
+		return buf;
+	}
+
+	//! @brief read the next line (without delim) as file_ptr::getline does
+	std::optional<std::string> getline(char delim = '\n')
+	{
+		std::string ret;
+		while (fill_current())
+		{
+			const auto * begin = m_current_ + m_pos_;
+			const auto avail = m_current_size_ - m_pos_;
+			if (const auto * found = static_cast<const char *>(std::memchr(begin, delim, avail)))
+			{
+				const auto len = static_cast<std::size_t>(found - begin);
+				ret.append(begin, len);
+				m_pos_ += len + 1;
+				m_consumed_bytes_ += len + 1;
+				return ret;
+			}
+			ret.append(begin, avail);
+			m_pos_ += avail;
+			m_consumed_bytes_ += avail;
+		}
+		return ret.empty() ? std::nullopt : std::optional<std::string>{std::move(ret)};
+	}
+
+	//! @brief bytes consumed since construction
+	std::uint64_t tell() const { return m_consumed_bytes_; }
+
+	//! @brief true once every byte of the file has been consumed
+	bool eof()
+	{
+		return !fill_current();
+	}
+
+	//! @brief true if the helper thread hit a read error
+	bool error() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex_);
+		return m_error_;
+	}
+
+private:
+	void advise_sequential()
+	{
+		#if defined(POSIX_FADV_SEQUENTIAL)
+		const auto fd = ::fileno(m_file_.get());
+		const auto pos = ::ftello(m_file_.get());
+		if (pos >= 0)
+			::posix_fadvise(fd, pos, 0, POSIX_FADV_SEQUENTIAL);
+		#endif
+	}
+
+	void advise_window([[maybe_unused]] std::uint64_t offset)
+	{
+		#if defined(POSIX_FADV_WILLNEED)
+		const auto window = m_options_.buffer_size * m_options_.buffer_count;
+		::posix_fadvise(::fileno(m_file_.get()), static_cast<off_t>(offset), static_cast<off_t>(window), POSIX_FADV_WILLNEED);
+		#endif
+	}
+
+	//! @brief make sure the current buffer has unread bytes; false at EOF
+	bool fill_current()
+	{
+		if (m_current_ && m_pos_ < m_current_size_)
+			return true;
+		if (!m_thread_.joinable())
+			return false;
+
+		std::unique_lock<std::mutex> lock(m_mutex_);
+		if (m_current_)
+		{
+			// hand the exhausted buffer back to the helper thread
+			m_current_ = nullptr;
+			++m_released_;
+			m_cv_.notify_all();
+		}
+		m_cv_.wait(lock, [this] { return m_released_ < m_filled_ || m_done_; });
+		if (m_released_ == m_filled_)
+			return false;
+		const auto index = m_released_ % m_buffers_.size();
+		m_current_ = m_buffers_[index].get();
+		m_current_size_ = m_sizes_[index];
+		m_pos_ = 0;
+		return m_current_size_ != 0;
+	}
+
+	void run()
+	{
+		auto offset = static_cast<std::uint64_t>((std::max)(m_file_.tell(), 0L));
+		for (;;)
+		{
+			std::size_t index;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex_);
+				m_cv_.wait(lock, [this] { return m_stop_ || m_filled_ - m_released_ < m_buffers_.size(); });
+				if (m_stop_)
+					return;
+				index = m_filled_ % m_buffers_.size();
+			}
+
+			advise_window(offset);
+			const auto got = m_file_.read(m_buffers_[index].get(), m_options_.buffer_size);
+			offset += got;
+
+			std::lock_guard<std::mutex> lock(m_mutex_);
+			m_sizes_[index] = got;
+			if (got != 0)
+				++m_filled_;
+			if (got != m_options_.buffer_size)
+			{
+				m_error_ = m_file_.error();
+				m_done_ = true;
+			}
+			m_cv_.notify_all();
+			if (m_done_)
+				return;
+		}
+	}
+
+	file_ptr m_file_;
+	prefetch_options m_options_;
+	std::vector<std::unique_ptr<char[]>> m_buffers_;
+	std::vector<std::size_t> m_sizes_;
+
+	// consumer side only
+	const char * m_current_{nullptr};
+	std::size_t m_current_size_{0};
+	std::size_t m_pos_{0};
+	std::uint64_t m_consumed_bytes_{0};
+
+	// buffers are filled and released in round-robin order
+	mutable std::mutex m_mutex_;
+	std::condition_variable m_cv_;
+	std::uint64_t m_filled_{0};
+	std::uint64_t m_released_{0};
+	bool m_done_{false};
+	bool m_error_{false};
+	bool m_stop_{false};
+
+	std::thread m_thread_;
+}; // prefetching_reader
+
+} // namespace msl
+#endif // MSL_PREFETCH_H__
@@ -0,0 +1,172 @@
+#ifndef MSL_ROLLING_FILE_H__
+#define MSL_ROLLING_FILE_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "file_ptr.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace msl
+{
+
+struct rolling_file_options
+{
+	//! @brief disk space reserved ahead of the writes each time the previous extent is used up
+	std::uint64_t extent{std::uint64_t{64} << 20};
+	//! @brief start writeback every window bytes and wait for the window before it (sync_file_range on Linux); 0 disables
+	std::uint64_t writeback_window{0};
+};
+
+//! @brief append-only file grown in large preallocated extents and truncated back to the written size on close()
+//! @note the extent is reserved without changing the file size where the platform allows it; otherwise the file is
+//! extended with zeroes, which a crash before close() leaves behind
+class rolling_file
+{
+public:
+	rolling_file() = default;
+	explicit rolling_file(const std::string_view & path, const rolling_file_options & options = {}) { open(path, options); }
+
+	rolling_file(const rolling_file &) = delete;
+	rolling_file & operator=(const rolling_file &) = delete;
+	~rolling_file() { close(); }
+
+	//! @brief open path for appending (created if missing), closing any previous file; check error() on failure
+	bool open(const std::string_view & path, const rolling_file_options & options = {})
+	{
+		close();
+		m_options_ = options;
+		m_error_ = {};
+		errno = 0;
+		m_file_.open(path, "r+b");
+		if (!m_file_ && errno == ENOENT)
+			m_file_.open(path, "w+b");
+		if (!m_file_)
+		{
+			m_error_ = errno != 0 ? std::error_code(errno, std::generic_category()) : std::make_error_code(std::errc::io_error);
+			return false;
+		}
+		m_file_.seek(0, SEEK_END);
+		m_size_ = m_reserved_ = m_started_ = m_waited_ = static_cast<std::uint64_t>((std::max)(m_file_.tell64(), std::int64_t{0}));
+		return true;
+	}
+
+	//! @brief append data, reserving a new extent first when the current one is used up
+	//! @return bytes written
+	std::size_t write(std::span<const std::byte> data)
+	{
+		if (!m_file_ || m_error_ || data.empty())
+			return 0;
+		reserve(data.size());
+		const auto n = std::fwrite(data.data(), 1, data.size(), m_file_.get());
+		m_size_ += n;
+		if (n != data.size())
+			m_error_ = std::make_error_code(std::errc::io_error);
+		writeback();
+		return n;
+	}
+	std::size_t write(const void * data, std::size_t size) { return write(std::span<const std::byte>(static_cast<const std::byte *>(data), size)); }
+	std::size_t string_write(const std::string_view & str) { return write(std::as_bytes(std::span(str))); }
+
+	//! @brief flush the stdio buffer
+	void flush() const { m_file_.flush(); }
+	//! @brief flush and fsync
+	bool sync() const { return m_file_ && m_file_.sync(); }
+
+	//! @brief flush, give the unused part of the extent back (truncate to size()) and close
+	//! @return the first error met while writing or closing
+	std::error_code close()
+	{
+		if (!m_file_)
+			return m_error_;
+		m_file_.flush();
+		if (m_file_.error() && !m_error_)
+			m_error_ = std::make_error_code(std::errc::io_error);
+		#ifdef _WIN32
+		const bool truncated = _chsize_s(_fileno(m_file_.get()), static_cast<__int64>(m_size_)) == 0;
+		#else
+		const bool truncated = ::ftruncate(::fileno(m_file_.get()), static_cast<off_t>(m_size_)) == 0;
+		#endif
+		if (!truncated && !m_error_)
+			m_error_ = {errno, std::generic_category()};
+		m_file_.close();
+		m_size_ = m_reserved_ = m_started_ = m_waited_ = 0;
+		return m_error_;
+	}
+
+	bool is_open() const { return static_cast<bool>(m_file_); }
+	explicit operator bool() const { return is_open() && !m_error_; }
+	std::error_code error() const { return m_error_; }
+	//! @brief bytes in the file, including the ones still in the stdio buffer
+	std::uint64_t size() const { return m_size_; }
+	//! @brief end of the space reserved so far (at least size())
+	std::uint64_t reserved() const { return (std::max)(m_reserved_, m_size_); }
+
+private:
+	void reserve(std::size_t incoming)
+	{
+		if (m_size_ + incoming <= m_reserved_)
+			return;
+		const auto bytes = (std::max)(m_options_.extent, static_cast<std::uint64_t>(incoming));
+		// preallocation is only a hint: when neither form is available the write simply grows the file
+		if (m_file_.preallocate(bytes, true))
+			m_file_.preallocate(bytes, false);
+		m_reserved_ = m_size_ + bytes;
+	}
+
+	void writeback()
+	{
+		if (m_options_.writeback_window == 0 || m_size_ - m_started_ < m_options_.writeback_window)
+			return;
+		m_file_.flush();
+		#if defined(__linux__) && defined(SYNC_FILE_RANGE_WRITE)
+		const int fd = ::fileno(m_file_.get());
+		::sync_file_range(fd, static_cast<off_t>(m_started_), static_cast<off_t>(m_size_ - m_started_), SYNC_FILE_RANGE_WRITE);
+		// wait for the previous window so that at most two windows of dirty pages are outstanding
+		if (m_started_ > m_waited_)
+			::sync_file_range(fd, static_cast<off_t>(m_waited_), static_cast<off_t>(m_started_ - m_waited_),
+				SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+		#endif
+		m_waited_ = m_started_;
+		m_started_ = m_size_;
+	}
+
+	file_ptr m_file_;
+	rolling_file_options m_options_;
+	std::error_code m_error_;
+	std::uint64_t m_size_{0};
+	std::uint64_t m_reserved_{0};
+	std::uint64_t m_started_{0};
+	std::uint64_t m_waited_{0};
+}; // rolling_file
+
+} // namespace msl
+#endif // MSL_ROLLING_FILE_H__
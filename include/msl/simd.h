@@ -0,0 +1,357 @@
+#ifndef MSL_SIMD_H__
+#define MSL_SIMD_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MSL_SIMD_HAS_SSE2
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MSL_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+//! @brief MSL_SIMD_TARGET(isa) compiles one function for an ISA above the build baseline (runtime dispatched)
+#if defined(MSL_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MSL_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MSL_SIMD_TARGET(isa)
+#endif
+
+namespace msl
+{
+namespace simd
+{
+
+//! @brief CPU features queried once at runtime
+struct cpu_features
+{
+	bool sse42{false};
+	bool avx2{false};
+};
+
+namespace details
+{
+inline cpu_features detect_cpu_features() noexcept
+{
+	cpu_features features;
+	#if defined(MSL_SIMD_X86) && defined(_MSC_VER)
+	int regs[4]{};
+	__cpuid(regs, 0);
+	const int max_leaf = regs[0];
+	__cpuid(regs, 1);
+	features.sse42 = (regs[2] & (1 << 20)) != 0;
+	const bool osxsave = (regs[2] & (1 << 27)) != 0;
+	const bool avx = (regs[2] & (1 << 28)) != 0;
+	if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+	{
+		__cpuidex(regs, 7, 0);
+		features.avx2 = (regs[1] & (1 << 5)) != 0;
+	}
+	#elif defined(MSL_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+	__builtin_cpu_init();
+	features.sse42 = __builtin_cpu_supports("sse4.2");
+	features.avx2 = __builtin_cpu_supports("avx2");
+	#endif
+	return features;
+}
+} // namespace details
+
+//! @brief cpu returns the features of the running CPU (all false off x86)
+inline const cpu_features & cpu() noexcept
+{
+	static const cpu_features features = details::detect_cpu_features();
+	return features;
+}
+
+//! @brief find_first_of2 returns the first position of a or b in [first, last), or last
+//! @note scans 16 bytes per iteration with SSE2 (x86 baseline), byte by byte elsewhere
+inline const char * find_first_of2(const char * first, const char * last, char a, char b) noexcept
+{
+	#ifdef MSL_SIMD_HAS_SSE2
+	const auto va = _mm_set1_epi8(a);
+	const auto vb = _mm_set1_epi8(b);
+	while (last - first >= 16)
+	{
+		const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+		const auto hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb));
+		const auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+		if (mask != 0)
+			return first + std::countr_zero(mask);
+		first += 16;
+	}
+	#endif
+	for (; first != last; ++first)
+	{
+		if (*first == a || *first == b)
+			return first;
+	}
+	return last;
+}
+
+namespace details
+{
+#ifdef MSL_SIMD_HAS_SSE2
+//! @brief 16 bytes per step: compare against each member of a set of at most 16 characters
+template <bool Member> inline const char * byte_set_scan_sse2(const char * first, const char * last, const char * chars, std::size_t count) noexcept
+{
+	__m128i needles[16];
+	for (std::size_t i = 0; i < count; ++i)
+		needles[i] = _mm_set1_epi8(chars[i]);
+	while (last - first >= 16)
+	{
+		const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+		auto hits = _mm_setzero_si128();
+		for (std::size_t i = 0; i < count; ++i)
+			hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, needles[i]));
+		auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+		if constexpr (!Member)
+			mask ^= 0xFFFFu;
+		if (mask != 0)
+			return first + std::countr_zero(mask);
+		first += 16;
+	}
+	return first;
+}
+#endif
+
+#ifdef MSL_SIMD_X86
+//! @brief 32 bytes per step: nibble classifier, a byte is a member when lo[b & 15] & hi[b >> 4] != 0
+template <bool Member>
+MSL_SIMD_TARGET("avx2") inline const char * byte_set_scan_avx2(const char * first, const char * last, const std::uint8_t * lo, const std::uint8_t * hi) noexcept
+{
+	const auto lo_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(lo)));
+	const auto hi_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(hi)));
+	const auto nibble = _mm256_set1_epi8(0x0F);
+	const auto zero = _mm256_setzero_si256();
+	while (last - first >= 32)
+	{
+		const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+		const auto lo_bits = _mm256_shuffle_epi8(lo_table, _mm256_and_si256(chunk, nibble));
+		const auto hi_bits = _mm256_shuffle_epi8(hi_table, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble));
+		const auto outside = _mm256_cmpeq_epi8(_mm256_and_si256(lo_bits, hi_bits), zero);
+		auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(outside));
+		if constexpr (Member)
+			mask = ~mask;
+		if (mask != 0)
+			return first + std::countr_zero(mask);
+		first += 32;
+	}
+	return first;
+}
+#endif
+} // namespace details
+
+//! @brief byte_set is a set of byte values built once and reused for vectorised any-of scans
+//! @note scans use a nibble classifier with AVX2 (sets spanning at most 8 distinct high nibbles), per-member SSE2
+//! compares for sets of at most 16 bytes, and a 256-bit bitmap otherwise and for the tail
+class byte_set
+{
+public:
+	constexpr byte_set() = default;
+	explicit byte_set(std::string_view chars) noexcept
+	{
+		std::uint8_t high_nibbles = 0;
+		std::array<std::int8_t, 16> high_bit;
+		high_bit.fill(-1);
+		for (const auto ch : chars)
+		{
+			const auto c = static_cast<unsigned char>(ch);
+			if (contains(ch))
+				continue;
+			m_bits_[c >> 6] |= std::uint64_t{1} << (c & 63);
+			if (m_count_ < m_chars_.size())
+				m_chars_[m_count_] = ch;
+			++m_count_;
+
+			auto & bit = high_bit[c >> 4];
+			if (bit < 0)
+			{
+				if (high_nibbles == 8)
+				{
+					m_nibble_ = false;
+					continue;
+				}
+				bit = static_cast<std::int8_t>(high_nibbles++);
+				m_hi_[c >> 4] = static_cast<std::uint8_t>(1u << bit);
+			}
+			m_lo_[c & 15] |= static_cast<std::uint8_t>(1u << bit);
+		}
+	}
+
+	bool contains(char ch) const noexcept
+	{
+		const auto c = static_cast<unsigned char>(ch);
+		return (m_bits_[c >> 6] >> (c & 63)) & 1u;
+	}
+	std::size_t size() const noexcept { return m_count_; }
+	bool empty() const noexcept { return m_count_ == 0; }
+
+	//! @brief first byte of [first, last) in the set, or last
+	const char * find(const char * first, const char * last) const noexcept { return scan<true>(first, last); }
+	//! @brief first byte of [first, last) not in the set, or last
+	const char * find_not(const char * first, const char * last) const noexcept { return scan<false>(first, last); }
+	//! @brief last byte of [first, last) not in the set, or last if every byte is in it
+	//! @note a scalar backward scan: meant for short runs such as trailing whitespace
+	const char * rfind_not(const char * first, const char * last) const noexcept
+	{
+		for (auto it = last; it != first;)
+		{
+			if (!contains(*--it))
+				return it;
+		}
+		return last;
+	}
+
+private:
+	template <bool Member> const char * scan(const char * first, const char * last) const noexcept
+	{
+		if (m_count_ == 0)
+			return Member ? last : first;
+		#ifdef MSL_SIMD_X86
+		if (m_nibble_ && cpu().avx2)
+			first = details::byte_set_scan_avx2<Member>(first, last, m_lo_.data(), m_hi_.data());
+		#endif
+		#ifdef MSL_SIMD_HAS_SSE2
+		if (m_count_ <= m_chars_.size())
+			first = details::byte_set_scan_sse2<Member>(first, last, m_chars_.data(), m_count_);
+		#endif
+		for (; first != last; ++first)
+		{
+			if (contains(*first) == Member)
+				return first;
+		}
+		return last;
+	}
+
+	std::array<std::uint64_t, 4> m_bits_{};
+	std::array<std::uint8_t, 16> m_lo_{};
+	std::array<std::uint8_t, 16> m_hi_{};
+	std::array<char, 16> m_chars_{};
+	std::size_t m_count_{0};
+	bool m_nibble_{true};
+}; // byte_set
+
+namespace details
+{
+#ifdef MSL_SIMD_HAS_SSE2
+//! @brief 0xFF in every byte of v within [lo, hi] (bytes >= 0x80 compare as negative and never match)
+inline __m128i ascii_range_mask_sse2(__m128i v, char lo, char hi) noexcept
+{
+	return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))), _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1))));
+}
+
+//! @brief 16 bytes per step: flip the 0x20 case bit of the letters in [First, First + 25]
+template <char First> inline char * ascii_flip_case_sse2(char * first, char * last) noexcept
+{
+	const auto bit = _mm_set1_epi8(0x20);
+	while (last - first >= 16)
+	{
+		const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+		const auto mask = ascii_range_mask_sse2(chunk, First, static_cast<char>(First + 25));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(first), _mm_xor_si128(chunk, _mm_and_si128(mask, bit)));
+		first += 16;
+	}
+	return first;
+}
+#endif
+
+#ifdef MSL_SIMD_X86
+//! @brief 32 bytes per step: flip the 0x20 case bit of the letters in [First, First + 25]
+template <char First> MSL_SIMD_TARGET("avx2") inline char * ascii_flip_case_avx2(char * first, char * last) noexcept
+{
+	const auto lo = _mm256_set1_epi8(static_cast<char>(First - 1));
+	const auto hi = _mm256_set1_epi8(static_cast<char>(First + 26));
+	const auto bit = _mm256_set1_epi8(0x20);
+	while (last - first >= 32)
+	{
+		const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+		const auto mask = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, lo), _mm256_cmpgt_epi8(hi, chunk));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(first), _mm256_xor_si256(chunk, _mm256_and_si256(mask, bit)));
+		first += 32;
+	}
+	return first;
+}
+#endif
+
+template <char First> inline void ascii_flip_case(char * first, char * last) noexcept
+{
+	#ifdef MSL_SIMD_X86
+	if (cpu().avx2)
+		first = ascii_flip_case_avx2<First>(first, last);
+	#endif
+	#ifdef MSL_SIMD_HAS_SSE2
+	first = ascii_flip_case_sse2<First>(first, last);
+	#endif
+	for (; first != last; ++first)
+	{
+		if (*first >= First && *first <= First + 25)
+			*first = static_cast<char>(*first ^ 0x20);
+	}
+}
+} // namespace details
+
+//! @brief ascii_to_lower converts the ASCII uppercase letters of [first, last) to lowercase; other bytes are untouched
+//! @note 32 bytes per step with AVX2 (runtime dispatched), 16 with SSE2, byte by byte elsewhere
+inline void ascii_to_lower(char * first, char * last) noexcept { details::ascii_flip_case<'A'>(first, last); }
+//! @brief ascii_to_upper converts the ASCII lowercase letters of [first, last) to uppercase; other bytes are untouched
+inline void ascii_to_upper(char * first, char * last) noexcept { details::ascii_flip_case<'a'>(first, last); }
+
+//! @brief ascii_iequal compares n bytes of a and b ignoring ASCII case, 16 bytes per step with SSE2
+inline bool ascii_iequal(const char * a, const char * b, std::size_t n) noexcept
+{
+	#ifdef MSL_SIMD_HAS_SSE2
+	const auto bit = _mm_set1_epi8(0x20);
+	for (; n >= 16; n -= 16, a += 16, b += 16)
+	{
+		const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+		const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+		const auto la = _mm_or_si128(va, _mm_and_si128(details::ascii_range_mask_sse2(va, 'A', 'Z'), bit));
+		const auto lb = _mm_or_si128(vb, _mm_and_si128(details::ascii_range_mask_sse2(vb, 'A', 'Z'), bit));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(la, lb)) != 0xFFFF)
+			return false;
+	}
+	#endif
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		auto ca = a[i];
+		auto cb = b[i];
+		if (ca != cb)
+		{
+			ca = (ca >= 'A' && ca <= 'Z') ? static_cast<char>(ca | 0x20) : ca;
+			cb = (cb >= 'A' && cb <= 'Z') ? static_cast<char>(cb | 0x20) : cb;
+			if (ca != cb)
+				return false;
+		}
+	}
+	return true;
+}
+
+} // namespace simd
+} // namespace msl
+#endif // MSL_SIMD_H__
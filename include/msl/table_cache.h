@@ -0,0 +1,352 @@
+#ifndef MSL_TABLE_CACHE_H__
+#define MSL_TABLE_CACHE_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "atomic_writer.h"
+#include "file_ptr.h"
+#include "hash.h"
+#include "mapped_file.h"
+#include "traits.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace msl
+{
+
+//! @brief reference to a string stored in the table cache heap
+struct table_string
+{
+	std::uint32_t offset{0};
+	std::uint32_t size{0};
+};
+
+//! @brief identity of the source a cache was built from
+struct table_source_stamp
+{
+	std::uint64_t size{0};
+	std::int64_t mtime{0};
+	std::uint64_t hash{0};
+};
+
+//! @brief how much of the source open() checks before trusting a cache
+enum class table_cache_validation
+{
+	metadata, // size and mtime only
+	content, // size, mtime and content hash
+};
+
+enum class table_cache_status
+{
+	ok,
+	missing, // no cache file yet
+	stale, // source changed since the cache was written
+	incompatible, // other format/schema version, row layout or byte order
+	corrupt, // truncated or inconsistent cache file
+	source_error, // source file could not be read
+};
+
+namespace details
+{
+inline constexpr std::array<char, 8> table_cache_magic{'M', 'S', 'L', 'T', 'B', 'L', 'C', '\0'};
+inline constexpr std::uint32_t table_cache_format_version = 1;
+inline constexpr std::uint32_t table_cache_byte_order = 0x01020304;
+inline constexpr std::uint64_t table_cache_rows_offset = 128;
+
+//! @brief on-disk header; every offset is relative to the start of the file
+struct table_cache_header
+{
+	std::array<char, 8> magic{};
+	std::uint32_t byte_order{0};
+	std::uint32_t format_version{0};
+	std::uint32_t schema_version{0};
+	std::uint32_t row_size{0};
+	std::uint64_t row_count{0};
+	std::uint64_t rows_offset{0};
+	std::uint64_t heap_offset{0};
+	std::uint64_t heap_size{0};
+	std::uint64_t source_size{0};
+	std::int64_t source_mtime{0};
+	std::uint64_t source_hash{0};
+};
+
+//! @brief 64-bit content hash of the cache source
+inline std::uint64_t table_cache_hash(std::string_view data)
+{
+	return xxhash64::hash(data);
+}
+
+//! @brief size and mtime of path, without the content hash
+inline std::optional<table_source_stamp> table_source_metadata(const std::string_view & path)
+{
+	std::error_code ec;
+	const std::filesystem::path fs_path(std::string{path});
+	const auto size = std::filesystem::file_size(fs_path, ec);
+	if (ec)
+		return std::nullopt;
+	const auto mtime = std::filesystem::last_write_time(fs_path, ec);
+	if (ec)
+		return std::nullopt;
+	table_source_stamp stamp;
+	stamp.size = static_cast<std::uint64_t>(size);
+	stamp.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+	return stamp;
+}
+} // namespace details
+
+//! @brief stamp_table_source reads size, mtime and content hash of a cache source file
+inline std::optional<table_source_stamp> stamp_table_source(const std::string_view & path)
+{
+	auto stamp = details::table_source_metadata(path);
+	if (!stamp)
+		return std::nullopt;
+	const mapped_file source(path);
+	if (!source)
+		return std::nullopt;
+	stamp->hash = details::table_cache_hash(source.view());
+	return stamp;
+}
+
+//! @brief collects fixed-width rows plus a deduplicated string heap and writes them as a cache file
+template <typename Row>
+requires traits::is_raw_v<Row>
+class table_cache_writer
+{
+public:
+	//! @brief copy str into the heap (once per distinct value) and return its reference
+	//! @note table_string references are 32-bit: a heap growing past 4 GiB returns an empty reference and fails write()
+	table_string add_string(std::string_view str)
+	{
+		if (const auto it = m_strings_.find(std::string(str)); it != m_strings_.end())
+			return it->second;
+		// every accepted string keeps the heap within the limit, so the subtraction cannot wrap
+		constexpr std::size_t heap_limit = std::numeric_limits<std::uint32_t>::max();
+		if (str.size() > heap_limit - m_heap_.size())
+		{
+			m_heap_overflow_ = true;
+			return {};
+		}
+		const table_string ref{static_cast<std::uint32_t>(m_heap_.size()), static_cast<std::uint32_t>(str.size())};
+		m_heap_.insert(m_heap_.end(), str.begin(), str.end());
+		m_strings_.emplace(std::string(str), ref);
+		return ref;
+	}
+
+	void add_row(const Row & row) { m_rows_.push_back(row); }
+	void reserve(std::size_t rows) { m_rows_.reserve(rows); }
+	std::size_t size() const { return m_rows_.size(); }
+	std::span<const Row> rows() const { return m_rows_; }
+
+	//! @brief write the cache through an atomic_writer so it replaces cache_path in one rename
+	//! @note readers that still map the previous cache keep their (unlinked) copy; the header goes in last
+	std::error_code write(const std::string_view & cache_path, const table_source_stamp & source, std::uint32_t schema_version) const
+	{
+		if (m_heap_overflow_)
+			return std::make_error_code(std::errc::value_too_large);
+		details::table_cache_header header;
+		header.magic = details::table_cache_magic;
+		header.byte_order = details::table_cache_byte_order;
+		header.format_version = details::table_cache_format_version;
+		header.schema_version = schema_version;
+		header.row_size = sizeof(Row);
+		header.row_count = m_rows_.size();
+		header.rows_offset = details::table_cache_rows_offset;
+		header.heap_offset = header.rows_offset + header.row_count * sizeof(Row);
+		header.heap_size = m_heap_.size();
+		header.source_size = source.size;
+		header.source_mtime = source.mtime;
+		header.source_hash = source.hash;
+		static_assert(sizeof(details::table_cache_header) <= details::table_cache_rows_offset);
+
+		atomic_writer writer(cache_path);
+		if (!writer)
+			return writer.error();
+		auto & file = writer.file();
+		const std::array<char, details::table_cache_rows_offset> blank{};
+		bool ok = file.write(static_cast<const void *>(blank.data()), blank.size()) == blank.size();
+		ok = ok && file.write(m_rows_.data(), m_rows_.size() * sizeof(Row)) == m_rows_.size() * sizeof(Row);
+		ok = ok && file.write(static_cast<const void *>(m_heap_.data()), m_heap_.size()) == m_heap_.size();
+		file.flush();
+		if (ok)
+		{
+			file.seek(0);
+			ok = file.write(header);
+		}
+		if (!ok)
+			return std::make_error_code(std::errc::io_error); // the writer removes its temporary file
+		return writer.commit(false); // a cache can always be rebuilt: skip the fsyncs
+	}
+
+private:
+	std::vector<Row> m_rows_;
+	std::vector<char> m_heap_;
+	std::unordered_map<std::string, table_string> m_strings_;
+	bool m_heap_overflow_{false}; // an add_string did not fit the 32-bit heap references
+}; // table_cache_writer
+
+//! @brief read-only view of a cache file: one mapping, no parsing
+template <typename Row>
+requires traits::is_raw_v<Row>
+class table_cache
+{
+public:
+	//! @brief map cache_path and validate it against source_path; the view is usable only on ok
+	table_cache_status open(const std::string_view & cache_path, const std::string_view & source_path, std::uint32_t schema_version,
+		table_cache_validation validation = table_cache_validation::content)
+	{
+		reset();
+		m_file_.open(cache_path);
+		if (!m_file_)
+			return m_file_.error() == std::errc::no_such_file_or_directory ? table_cache_status::missing : table_cache_status::corrupt;
+
+		const auto status = check_layout(schema_version);
+		if (status != table_cache_status::ok)
+		{
+			reset();
+			return status;
+		}
+
+		const auto stamp = details::table_source_metadata(source_path);
+		if (!stamp)
+		{
+			reset();
+			return table_cache_status::source_error;
+		}
+		if (stamp->size != m_header_.source_size || stamp->mtime != m_header_.source_mtime)
+		{
+			reset();
+			return table_cache_status::stale;
+		}
+		if (validation == table_cache_validation::content)
+		{
+			const mapped_file source(source_path);
+			if (!source)
+			{
+				reset();
+				return table_cache_status::source_error;
+			}
+			if (details::table_cache_hash(source.view()) != m_header_.source_hash)
+			{
+				reset();
+				return table_cache_status::stale;
+			}
+		}
+		m_valid_ = true;
+		return table_cache_status::ok;
+	}
+
+	//! @brief open the cache, or rebuild it with build(writer, source_text) and reopen it when it is unusable
+	//! @return status of the final open (the write error, if any, is reported as source_error)
+	template <typename Build>
+	table_cache_status open_or_build(const std::string_view & cache_path, const std::string_view & source_path, std::uint32_t schema_version,
+		Build && build, table_cache_validation validation = table_cache_validation::content)
+	{
+		const auto status = open(cache_path, source_path, schema_version, validation);
+		if (status == table_cache_status::ok || status == table_cache_status::source_error)
+			return status;
+
+		auto stamp = details::table_source_metadata(source_path);
+		const mapped_file source(source_path);
+		if (!stamp || !source)
+			return table_cache_status::source_error;
+		stamp->hash = details::table_cache_hash(source.view());
+
+		table_cache_writer<Row> writer;
+		build(writer, source.view());
+		if (writer.write(cache_path, *stamp, schema_version))
+			return table_cache_status::source_error;
+		const auto rebuilt = open(cache_path, source_path, schema_version, table_cache_validation::metadata);
+		m_rebuilt_ = rebuilt == table_cache_status::ok;
+		return rebuilt;
+	}
+
+	void reset()
+	{
+		m_file_.reset();
+		m_header_ = {};
+		m_valid_ = false;
+		m_rebuilt_ = false;
+	}
+
+	bool is_open() const { return m_valid_; }
+	explicit operator bool() const { return m_valid_; }
+	//! @brief true if the last open_or_build had to rebuild the cache
+	bool rebuilt() const { return m_rebuilt_; }
+	//! @brief true if the rows are served straight from a memory mapping
+	bool is_mapped() const { return m_file_.is_mapped(); }
+
+	std::span<const Row> rows() const
+	{
+		if (!m_valid_)
+			return {};
+		return {reinterpret_cast<const Row *>(m_file_.data() + m_header_.rows_offset), static_cast<std::size_t>(m_header_.row_count)};
+	}
+	std::size_t size() const { return m_valid_ ? static_cast<std::size_t>(m_header_.row_count) : 0; }
+	const Row & operator[](std::size_t i) const { return rows()[i]; }
+
+	//! @brief resolve a heap reference stored in a row
+	std::string_view string(const table_string & ref) const
+	{
+		if (!m_valid_ || std::uint64_t{ref.offset} + ref.size > m_header_.heap_size)
+			return {};
+		return {m_file_.data() + m_header_.heap_offset + ref.offset, ref.size};
+	}
+
+	//! @brief stamp of the source recorded in the cache
+	table_source_stamp source_stamp() const { return {m_header_.source_size, m_header_.source_mtime, m_header_.source_hash}; }
+
+private:
+	table_cache_status check_layout(std::uint32_t schema_version)
+	{
+		if (m_file_.size() < sizeof(details::table_cache_header))
+			return table_cache_status::corrupt;
+		std::memcpy(&m_header_, m_file_.data(), sizeof(m_header_));
+		if (m_header_.magic != details::table_cache_magic)
+			return table_cache_status::corrupt;
+		if (m_header_.byte_order != details::table_cache_byte_order || m_header_.format_version != details::table_cache_format_version ||
+			m_header_.schema_version != schema_version || m_header_.row_size != sizeof(Row))
+			return table_cache_status::incompatible;
+		const auto rows_bytes = m_header_.row_count * sizeof(Row);
+		if (m_header_.rows_offset != details::table_cache_rows_offset || m_header_.row_count > m_file_.size() / sizeof(Row) ||
+			m_header_.heap_offset != m_header_.rows_offset + rows_bytes || m_header_.heap_offset > m_file_.size() ||
+			m_header_.heap_size != m_file_.size() - m_header_.heap_offset)
+			return table_cache_status::corrupt;
+		if (reinterpret_cast<std::uintptr_t>(m_file_.data() + m_header_.rows_offset) % alignof(Row) != 0)
+			return table_cache_status::corrupt;
+		return table_cache_status::ok;
+	}
+
+	mapped_file m_file_;
+	details::table_cache_header m_header_;
+	bool m_valid_{false};
+	bool m_rebuilt_{false};
+}; // table_cache
+
+} // namespace msl
+#endif // MSL_TABLE_CACHE_H__
@@ -0,0 +1,219 @@
+#ifndef MSL_TSV_H__
+#define MSL_TSV_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "mapped_file.h"
+#include "simd.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace msl
+{
+
+//! @brief parse_cell converts a whole cell with std::from_chars; nullopt if it is not entirely a T
+template <typename T> std::optional<T> parse_cell(std::string_view cell)
+{
+	if constexpr (std::is_same_v<T, std::string_view>)
+		return cell;
+	else if constexpr (std::is_same_v<T, std::string>)
+		return std::string(cell);
+	else if constexpr (std::is_same_v<T, bool>)
+	{
+		if (cell == "1" || cell == "true")
+			return true;
+		if (cell == "0" || cell == "false")
+			return false;
+		return std::nullopt;
+	}
+	else if constexpr (std::is_floating_point_v<T>)
+	{
+		#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		T value{};
+		const auto [ptr, ec] = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+		if (ec != std::errc{} || ptr != cell.data() + cell.size())
+			return std::nullopt;
+		return value;
+		#else
+		// standard libraries without floating-point from_chars
+		const std::string str(cell);
+		char * end = nullptr;
+		const auto value = std::strtold(str.c_str(), &end);
+		if (str.empty() || end != str.c_str() + str.size())
+			return std::nullopt;
+		return static_cast<T>(value);
+		#endif
+	}
+	else
+	{
+		static_assert(std::is_integral_v<T>, "parse_cell supports arithmetic types, std::string and std::string_view");
+		T value{};
+		const auto [ptr, ec] = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+		if (ec != std::errc{} || ptr != cell.data() + cell.size())
+			return std::nullopt;
+		return value;
+	}
+}
+
+struct tsv_options
+{
+	char separator{'\t'};
+	bool skip_empty_lines{true};
+};
+
+//! @brief one parsed line; cells are views into the reader text and stay valid as long as it does
+class tsv_row
+{
+public:
+	std::size_t size() const { return m_cells_.size(); }
+	bool empty() const { return m_cells_.empty(); }
+	std::string_view operator[](std::size_t i) const { return m_cells_[i]; }
+	auto begin() const { return m_cells_.begin(); }
+	auto end() const { return m_cells_.end(); }
+
+	//! @brief cell i converted through parse_cell; nullopt if missing or not a T
+	template <typename T> std::optional<T> get(std::size_t i) const
+	{
+		if (i >= m_cells_.size())
+			return std::nullopt;
+		return parse_cell<T>(m_cells_[i]);
+	}
+
+	//! @brief the whole line without its line ending
+	std::string_view line() const { return m_line_; }
+	//! @brief byte offset of the line inside the parsed text
+	std::size_t offset() const { return m_offset_; }
+
+private:
+	friend class tsv_reader;
+	std::vector<std::string_view> m_cells_;
+	std::string_view m_line_;
+	std::size_t m_offset_{0};
+};
+
+//! @brief zero-copy reader for separator/newline tables (LF or CRLF) over an in-memory or mapped buffer
+class tsv_reader
+{
+public:
+	explicit tsv_reader(std::string_view text, tsv_options options = {}) : m_text_(text), m_options_(options) {}
+	//! @brief owning reader over a mapped file; a file that failed to map reads as empty, check error()
+	explicit tsv_reader(mapped_file file, tsv_options options = {}) :
+		m_file_(std::move(file)), m_text_(m_file_.view()), m_options_(options)
+	{
+	}
+
+	//! @brief false if the mapped file the reader was built from failed to open
+	explicit operator bool() const { return !m_file_.error(); }
+	//! @brief the mapping error of the owned mapped_file, if any
+	std::error_code error() const { return m_file_.error(); }
+
+	std::string_view text() const { return m_text_; }
+
+	//! @brief parse the next line into row (reusing its storage); false at the end of the text
+	bool next(tsv_row & row)
+	{
+		const char * const base = m_text_.data();
+		const char * const last = base + m_text_.size();
+		while (m_pos_ < m_text_.size())
+		{
+			const char * const line = base + m_pos_;
+			const char * cell = line;
+			row.m_cells_.clear();
+			for (;;)
+			{
+				const char * hit = simd::find_first_of2(cell, last, m_options_.separator, '\n');
+				if (hit != last && *hit != '\n')
+				{
+					row.m_cells_.emplace_back(cell, static_cast<std::size_t>(hit - cell));
+					cell = hit + 1;
+					continue;
+				}
+
+				const char * line_end = (hit != cell && hit[-1] == '\r') ? hit - 1 : hit;
+				line_end = (std::max)(line_end, cell);
+				row.m_cells_.emplace_back(cell, static_cast<std::size_t>(line_end - cell));
+				row.m_line_ = {line, static_cast<std::size_t>(line_end - line)};
+				row.m_offset_ = m_pos_;
+				m_pos_ = (hit == last) ? m_text_.size() : static_cast<std::size_t>(hit + 1 - base);
+				break;
+			}
+			if (m_options_.skip_empty_lines && row.m_line_.empty())
+				continue;
+			return true;
+		}
+		return false;
+	}
+
+	//! @brief restart from the first line
+	void rewind() { m_pos_ = 0; }
+
+	//! @brief call fn(const tsv_row &) for every remaining line
+	template <typename F> void for_each(F && fn)
+	{
+		tsv_row row;
+		while (next(row))
+			fn(static_cast<const tsv_row &>(row));
+	}
+
+	//! @brief parse newline-aligned chunks concurrently calling fn(chunk_index, const tsv_row &)
+	//! @return chunk count (<= threads), so callers can merge per-chunk accumulators indexed by chunk_index
+	template <typename F> std::size_t parallel_for_each(F && fn, std::size_t threads = 0) const
+	{
+		if (threads == 0)
+			threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+		const auto chunks = line_chunks(m_text_, threads);
+		const auto work = [&](std::size_t index) {
+			const auto chunk_offset = static_cast<std::size_t>(chunks[index].data() - m_text_.data());
+			tsv_reader reader(chunks[index], m_options_);
+			tsv_row row;
+			while (reader.next(row))
+			{
+				row.m_offset_ += chunk_offset;
+				fn(index, static_cast<const tsv_row &>(row));
+			}
+		};
+
+		std::vector<std::thread> workers;
+		for (std::size_t i = 1; i < chunks.size(); ++i)
+			workers.emplace_back(work, i);
+		if (!chunks.empty())
+			work(0);
+		for (auto & th : workers)
+			th.join();
+		return chunks.size();
+	}
+
+private:
+	mapped_file m_file_;
+	std::string_view m_text_;
+	tsv_options m_options_;
+	std::size_t m_pos_{0};
+}; // tsv_reader
+
+} // namespace msl
+#endif // MSL_TSV_H__
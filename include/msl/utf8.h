@@ -0,0 +1,313 @@
+#ifndef MSL_UTF8_H__
+#define MSL_UTF8_H__
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2026 martysama0134. All rights reserved.
+//
+// This code is licensed under the MIT License (MIT).
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "simd.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace msl
+{
+
+//! @brief outcome of a transcoding call: units consumed from the source and written to the destination
+//! @note on error, read points at the offending (or first unconverted) source unit
+struct transcode_result
+{
+	std::size_t read{0};
+	std::size_t written{0};
+	std::error_code error;
+
+	explicit operator bool() const { return !error; }
+};
+
+//! @brief utf8_bound is the largest UTF-8 size of wide_size wchar_t units (3 per UTF-16 unit, 4 per UTF-32 unit)
+constexpr std::size_t utf8_bound(std::size_t wide_size) noexcept { return wide_size * (sizeof(wchar_t) == 2 ? 3 : 4); }
+
+//! @brief wide_bound is the largest wchar_t count decoded from utf8_size bytes
+constexpr std::size_t wide_bound(std::size_t utf8_size) noexcept { return utf8_size; }
+
+namespace details
+{
+constexpr bool is_surrogate(std::uint32_t cp) noexcept { return cp >= 0xD800 && cp <= 0xDFFF; }
+
+// GCC 12 reports the 16-byte stores below as out of bounds (-Warray-bounds) once this is inlined into utf8_from_wide
+// with a caller buffer shorter than 16 bytes; the vector loop only runs while 16 units fit, so the path is dead
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+//! @brief copy the leading ASCII run of src as UTF-8; returns the units copied (at most n)
+inline std::size_t ascii_from_wide(const wchar_t * src, char * dst, std::size_t n) noexcept
+{
+	std::size_t i = 0;
+	#ifdef MSL_SIMD_HAS_SSE2
+	const auto zero = _mm_setzero_si128();
+	if constexpr (sizeof(wchar_t) == 2)
+	{
+		const auto high = _mm_set1_epi16(static_cast<short>(0xFF80));
+		for (; n - i >= 16; i += 16)
+		{
+			const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+			const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_or_si128(a, b), high), zero)) != 0xFFFF)
+				break;
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(a, b));
+		}
+	}
+	else
+	{
+		const auto high = _mm_set1_epi32(static_cast<int>(0xFFFFFF80u));
+		for (; n - i >= 16; i += 16)
+		{
+			const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+			const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 4));
+			const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+			const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 12));
+			const auto all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(all, high), zero)) != 0xFFFF)
+				break;
+			const auto lo = _mm_packs_epi32(a, b);
+			const auto hi = _mm_packs_epi32(c, d);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+		}
+	}
+	#endif
+	for (; i < n && static_cast<std::uint32_t>(src[i]) < 0x80; ++i)
+		dst[i] = static_cast<char>(src[i]);
+	return i;
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+//! @brief widen the leading ASCII run of src; returns the bytes copied (at most n)
+inline std::size_t ascii_to_wide(const char * src, wchar_t * dst, std::size_t n) noexcept
+{
+	std::size_t i = 0;
+	#ifdef MSL_SIMD_HAS_SSE2
+	const auto zero = _mm_setzero_si128();
+	for (; n - i >= 16; i += 16)
+	{
+		const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+		if (_mm_movemask_epi8(bytes) != 0)
+			break;
+		const auto lo = _mm_unpacklo_epi8(bytes, zero);
+		const auto hi = _mm_unpackhi_epi8(bytes, zero);
+		if constexpr (sizeof(wchar_t) == 2)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), lo);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), hi);
+		}
+		else
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi16(lo, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+		}
+	}
+	#else
+	for (; n - i >= 8; i += 8)
+	{
+		std::uint64_t word;
+		std::memcpy(&word, src + i, sizeof(word));
+		if ((word & 0x8080808080808080ULL) != 0)
+			break;
+		for (std::size_t k = 0; k < 8; ++k)
+			dst[i + k] = static_cast<wchar_t>(static_cast<unsigned char>(src[i + k]));
+	}
+	#endif
+	for (; i < n && static_cast<unsigned char>(src[i]) < 0x80; ++i)
+		dst[i] = static_cast<wchar_t>(src[i]);
+	return i;
+}
+} // namespace details
+
+//! @brief utf8_from_wide encodes UTF-16 (Windows) or UTF-32 (elsewhere) wchar_t text into dst, independently of the C locale
+//! @note unpaired surrogates and out-of-range code points give illegal_byte_sequence; a short dst gives no_buffer_space
+inline transcode_result utf8_from_wide(std::wstring_view src, std::span<char> dst) noexcept
+{
+	transcode_result result;
+	const auto n = src.size();
+	auto & i = result.read;
+	auto & o = result.written;
+	while (i < n)
+	{
+		const auto room = dst.size() - o;
+		const auto ascii = details::ascii_from_wide(src.data() + i, dst.data() + o, (std::min)(n - i, room));
+		i += ascii;
+		o += ascii;
+		if (i == n)
+			break;
+
+		auto cp = static_cast<std::uint32_t>(src[i]);
+		std::size_t units = 1;
+		if constexpr (sizeof(wchar_t) == 2)
+		{
+			if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < n)
+			{
+				const auto low = static_cast<std::uint32_t>(src[i + 1]);
+				if (low >= 0xDC00 && low <= 0xDFFF)
+				{
+					cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+					units = 2;
+				}
+			}
+		}
+		if ((units == 1 && details::is_surrogate(cp)) || cp > 0x10FFFF)
+		{
+			result.error = std::make_error_code(std::errc::illegal_byte_sequence);
+			return result;
+		}
+
+		const std::size_t length = cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+		if (dst.size() - o < length)
+		{
+			result.error = std::make_error_code(std::errc::no_buffer_space);
+			return result;
+		}
+		auto * out = dst.data() + o;
+		switch (length)
+		{
+		case 1:
+			out[0] = static_cast<char>(cp);
+			break;
+		case 2:
+			out[0] = static_cast<char>(0xC0 | (cp >> 6));
+			out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+			break;
+		case 3:
+			out[0] = static_cast<char>(0xE0 | (cp >> 12));
+			out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+			break;
+		default:
+			out[0] = static_cast<char>(0xF0 | (cp >> 18));
+			out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+			out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+			break;
+		}
+		i += units;
+		o += length;
+	}
+	return result;
+}
+
+//! @brief wide_from_utf8 decodes UTF-8 into UTF-16 (Windows) or UTF-32 (elsewhere) wchar_t units in dst, independently of the C locale
+//! @note overlong forms, surrogates, code points above U+10FFFF and truncated sequences give illegal_byte_sequence
+inline transcode_result wide_from_utf8(std::string_view src, std::span<wchar_t> dst) noexcept
+{
+	transcode_result result;
+	const auto n = src.size();
+	auto & i = result.read;
+	auto & o = result.written;
+	const auto byte = [&](std::size_t k) { return static_cast<std::uint32_t>(static_cast<unsigned char>(src[k])); };
+	while (i < n)
+	{
+		const auto room = dst.size() - o;
+		const auto ascii = details::ascii_to_wide(src.data() + i, dst.data() + o, (std::min)(n - i, room));
+		i += ascii;
+		o += ascii;
+		if (i == n)
+			break;
+
+		const auto lead = byte(i);
+		std::size_t length;
+		std::uint32_t cp;
+		std::uint32_t min;
+		if (lead < 0x80)
+			length = 1, cp = lead, min = 0;
+		else if ((lead & 0xE0) == 0xC0)
+			length = 2, cp = lead & 0x1F, min = 0x80;
+		else if ((lead & 0xF0) == 0xE0)
+			length = 3, cp = lead & 0x0F, min = 0x800;
+		else if ((lead & 0xF8) == 0xF0)
+			length = 4, cp = lead & 0x07, min = 0x10000;
+		else
+		{
+			result.error = std::make_error_code(std::errc::illegal_byte_sequence);
+			return result;
+		}
+		if (n - i < length)
+		{
+			result.error = std::make_error_code(std::errc::illegal_byte_sequence);
+			return result;
+		}
+		for (std::size_t k = 1; k < length; ++k)
+		{
+			const auto next = byte(i + k);
+			if ((next & 0xC0) != 0x80)
+			{
+				result.error = std::make_error_code(std::errc::illegal_byte_sequence);
+				return result;
+			}
+			cp = (cp << 6) | (next & 0x3F);
+		}
+		if (cp < min || cp > 0x10FFFF || details::is_surrogate(cp))
+		{
+			result.error = std::make_error_code(std::errc::illegal_byte_sequence);
+			return result;
+		}
+
+		const std::size_t units = sizeof(wchar_t) == 2 && cp >= 0x10000 ? 2 : 1;
+		if (dst.size() - o < units)
+		{
+			result.error = std::make_error_code(std::errc::no_buffer_space);
+			return result;
+		}
+		if (units == 2)
+		{
+			dst[o] = static_cast<wchar_t>(0xD800 + ((cp - 0x10000) >> 10));
+			dst[o + 1] = static_cast<wchar_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+		}
+		else
+			dst[o] = static_cast<wchar_t>(cp);
+		i += length;
+		o += units;
+	}
+	return result;
+}
+
+//! @brief utf8_from_wide into a reusable string (resized to the encoded size)
+inline std::error_code utf8_from_wide(std::wstring_view src, std::string & out)
+{
+	out.resize(utf8_bound(src.size()));
+	const auto result = utf8_from_wide(src, std::span<char>(out));
+	out.resize(result.written);
+	return result.error;
+}
+
+//! @brief wide_from_utf8 into a reusable wstring (resized to the decoded size)
+inline std::error_code wide_from_utf8(std::string_view src, std::wstring & out)
+{
+	out.resize(wide_bound(src.size()));
+	const auto result = wide_from_utf8(src, std::span<wchar_t>(out));
+	out.resize(result.written);
+	return result.error;
+}
+
+} // namespace msl
+#endif // MSL_UTF8_H__
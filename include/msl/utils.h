@@ -17,10 +17,14 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "simd.h"
+
 #include <algorithm>
 #include <cmath>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <limits>
 #include <ranges>
@@ -48,58 +52,176 @@ template <typename T> inline void append_string_like(std::string & target, T &&
 }
 } // namespace details
 
-//! @brief string_split split a string into a vector by providing a single delim character
-template <class T = std::vector<std::string>> T string_split(const std::string & str, char tok = ' ')
+namespace details
 {
-	T vec{};
-	std::size_t prev = 0;
-	auto cur = str.find(tok);
-	while (cur != std::string::npos)
+struct split_char
+{
+	char delim;
+	std::size_t find(std::string_view text, std::size_t pos) const noexcept { return text.find(delim, pos); }
+	std::size_t size() const noexcept { return 1; }
+};
+
+struct split_string
+{
+	std::string_view delim;
+	std::size_t find(std::string_view text, std::size_t pos) const noexcept { return delim.empty() ? std::string_view::npos : text.find(delim, pos); }
+	std::size_t size() const noexcept { return delim.size(); }
+};
+
+struct split_any_of
+{
+	simd::byte_set delims;
+	std::size_t find(std::string_view text, std::size_t pos) const noexcept
 	{
-		vec.emplace_back(str.substr(prev, cur - prev));
-		prev = cur + 1;
-		cur = str.find(tok, prev);
+		const auto end = text.data() + text.size();
+		const auto found = delims.find(text.data() + pos, end);
+		return found == end ? std::string_view::npos : static_cast<std::size_t>(found - text.data());
 	}
-	vec.emplace_back(str.substr(prev, cur - prev));
+	std::size_t size() const noexcept { return 1; }
+};
+} // namespace details
+
+//! @brief lazy range of the std::string_view tokens between delimiters; empty tokens are kept like in string_split
+//! @note iterators hold their own copy of the text view and delimiter, so they outlive the view object (not the text)
+template <typename Delim> class basic_split_view : public std::ranges::view_interface<basic_split_view<Delim>>
+{
+public:
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+
+		iterator() = default;
+		iterator(std::string_view text, Delim delim, std::size_t begin) : m_text_(text), m_delim_(delim), m_begin_(begin)
+		{
+			if (m_begin_ != std::string_view::npos)
+				m_end_ = m_delim_.find(m_text_, m_begin_);
+		}
+
+		std::string_view operator*() const { return m_text_.substr(m_begin_, m_end_ - m_begin_); }
+		iterator & operator++()
+		{
+			if (m_end_ == std::string_view::npos)
+				m_begin_ = std::string_view::npos;
+			else
+			{
+				m_begin_ = m_end_ + m_delim_.size();
+				m_end_ = m_delim_.find(m_text_, m_begin_);
+			}
+			return *this;
+		}
+		iterator operator++(int)
+		{
+			auto copy = *this;
+			++*this;
+			return copy;
+		}
+		bool operator==(const iterator & other) const { return m_begin_ == other.m_begin_; }
+
+	private:
+		std::string_view m_text_;
+		Delim m_delim_{};
+		std::size_t m_begin_{std::string_view::npos};
+		std::size_t m_end_{std::string_view::npos};
+	};
+
+	basic_split_view() = default;
+	basic_split_view(std::string_view text, Delim delim) : m_text_(text), m_delim_(delim) {}
+
+	iterator begin() const { return {m_text_, m_delim_, 0}; }
+	iterator end() const { return {m_text_, m_delim_, std::string_view::npos}; }
+
+private:
+	std::string_view m_text_;
+	Delim m_delim_{};
+}; // basic_split_view
+
+//! @brief split_view lazily splits text on a single delim character without allocating
+inline basic_split_view<details::split_char> split_view(std::string_view text, char delim) { return {text, {delim}}; }
+
+//! @brief split_view lazily splits text on a delim string; an empty delim yields text as a single token
+inline basic_split_view<details::split_string> split_view(std::string_view text, std::string_view delim) { return {text, {delim}}; }
+
+//! @brief split_any lazily splits text on any of the delims characters
+inline basic_split_view<details::split_any_of> split_any(std::string_view text, const simd::byte_set & delims) { return {text, {delims}}; }
+inline basic_split_view<details::split_any_of> split_any(std::string_view text, std::string_view delims) { return split_any(text, simd::byte_set(delims)); }
+
+//! @brief split_into clears out and fills it with the tokens of text (reusing its capacity); returns the token count
+//! @note with std::vector<std::string_view> no allocation happens once the capacity has grown
+template <class T> std::size_t split_into(T & out, std::string_view text, char delim)
+{
+	out.clear();
+	for (const auto token : split_view(text, delim))
+		out.emplace_back(token);
+	return out.size();
+}
+
+//! @brief split_into by delim string
+template <class T> std::size_t split_into(T & out, std::string_view text, std::string_view delim)
+{
+	out.clear();
+	for (const auto token : split_view(text, delim))
+		out.emplace_back(token);
+	return out.size();
+}
+
+//! @brief split_any_into clears out and fills it with the tokens of text split on any of the delims characters
+template <class T> std::size_t split_any_into(T & out, std::string_view text, std::string_view delims)
+{
+	out.clear();
+	for (const auto token : split_any(text, delims))
+		out.emplace_back(token);
+	return out.size();
+}
+
+//! @brief string_split split a string into a vector by providing a single delim character
+template <class T = std::vector<std::string>> T string_split(std::string_view str, char tok = ' ')
+{
+	T vec{};
+	split_into(vec, str, tok);
 	return vec;
 }
 
 //! @brief string_split split a string into a vector by providing the delim string
-template <class T = std::vector<std::string>> T string_split(const std::string & str, const std::string & tok = " ")
+template <class T = std::vector<std::string>> T string_split(std::string_view str, std::string_view tok = " ")
 {
 	T vec{};
-	if (tok.empty())
-	{
-		vec.emplace_back(str);
-		return vec;
-	}
-
-	std::size_t prev = 0;
-	auto cur = str.find(tok);
-	while (cur != std::string::npos)
-	{
-		vec.emplace_back(str.substr(prev, cur - prev));
-		prev = cur + tok.size();
-		cur = str.find(tok, prev);
-	}
-	vec.emplace_back(str.substr(prev, cur - prev));
+	split_into(vec, str, tok);
 	return vec;
 }
 
 //! @brief string_split_any split a string into a vector by providing any of the single delim characters
-template <class T = std::vector<std::string>> T string_split_any(const std::string & str, const std::string & toks = " ")
+template <class T = std::vector<std::string>> T string_split_any(std::string_view str, std::string_view toks = " ")
 {
 	T vec{};
-	std::size_t prev = 0;
-	auto cur = str.find_first_of(toks);
-	while (cur != std::string::npos)
+	split_any_into(vec, str, toks);
+	return vec;
+}
+
+//! @brief line_chunks splits text into at most count chunks that end right after a '\n' (or at the end of text)
+inline std::vector<std::string_view> line_chunks(std::string_view text, std::size_t count)
+{
+	std::vector<std::string_view> chunks;
+	if (text.empty())
+		return chunks;
+	count = (std::max)(count, std::size_t{1});
+	const auto target = (text.size() + count - 1) / count;
+	std::size_t begin = 0;
+	while (begin < text.size())
 	{
-		vec.emplace_back(str.substr(prev, cur - prev));
-		prev = cur + 1;
-		cur = str.find_first_of(toks, prev);
+		auto end = begin + target;
+		if (end >= text.size())
+			end = text.size();
+		else if (const auto newline = text.find('\n', end - 1); newline != std::string_view::npos)
+			end = newline + 1;
+		else
+			end = text.size();
+		chunks.emplace_back(text.substr(begin, end - begin));
+		begin = end;
 	}
-	vec.emplace_back(str.substr(prev, cur - prev));
-	return vec;
+	return chunks;
 }
 
 //! @brief string_join joins a string-like range into a string by uniting elements with tok char
@@ -167,34 +289,95 @@ inline std::string string_replace(std::string str, const char from, const char t
 	return str;
 }
 
+//! @brief string_count returns the number of non-overlapping instances of 'from' in 'text' (0 if 'from' is empty)
+inline std::size_t string_count(std::string_view text, std::string_view from) noexcept
+{
+	if (from.empty())
+		return 0;
+	std::size_t count = 0;
+	for (auto pos = text.find(from); pos != std::string_view::npos; pos = text.find(from, pos + from.size()))
+		++count;
+	return count;
+}
+
+//! @brief replace_into writes 'text' with every instance of 'from' replaced by 'to' into 'out', sized once up front
+//! @note 'out' is overwritten (its capacity is reused) and must not alias 'text'
+//! @return the number of replacements
+inline std::size_t replace_into(std::string & out, std::string_view text, std::string_view from, std::string_view to)
+{
+	const auto count = string_count(text, from);
+	out.resize(text.size() - count * from.size() + count * to.size());
+	if (count == 0)
+	{
+		std::copy(text.begin(), text.end(), out.begin());
+		return 0;
+	}
+	auto dst = out.begin();
+	std::size_t pos = 0;
+	for (auto found = text.find(from); found != std::string_view::npos; found = text.find(from, pos))
+	{
+		dst = std::copy(text.begin() + pos, text.begin() + found, dst);
+		dst = std::copy(to.begin(), to.end(), dst);
+		pos = found + from.size();
+	}
+	std::copy(text.begin() + pos, text.end(), dst);
+	return count;
+}
+
 //! @brief string_replace_in_place replace all string instances of 'from' to 'to' from the input string
-inline void string_replace_in_place(std::string & str, const std::string & from, const std::string & to)
+//! @note linear time: equal or shorter replacements compact the string in a single pass, longer ones are copied once
+//! into an exactly sized buffer
+inline void string_replace_in_place(std::string & str, std::string_view from, std::string_view to)
 {
 	if (from.empty())
 		return;
-	std::size_t pos = 0;
-	while ((pos = str.find(from, pos)) != std::string::npos)
+	if (to.size() > from.size())
 	{
-		str.replace(pos, from.length(), to);
-		pos += to.length();
+		std::string out;
+		if (replace_into(out, str, from, to) != 0)
+			str.swap(out);
+		return;
 	}
+	const std::string_view text(str);
+	auto found = text.find(from);
+	if (found == std::string_view::npos)
+		return;
+	// the write position never overtakes the read position, so the string is rewritten over itself; while they are
+	// equal (always for same-length replacements) the kept text is already in place, and std::copy must not be given
+	// an output iterator inside its own source range
+	const auto keep = [&str](auto dst, std::size_t first, std::size_t last) {
+		if (dst == str.begin() + first)
+			return dst + (last - first);
+		return std::copy(str.begin() + first, str.begin() + last, dst);
+	};
+	auto dst = str.begin() + found;
+	std::size_t pos = found;
+	while (found != std::string_view::npos)
+	{
+		dst = keep(dst, pos, found);
+		dst = std::copy(to.begin(), to.end(), dst);
+		pos = found + from.size();
+		found = text.find(from, pos);
+	}
+	dst = keep(dst, pos, str.size());
+	str.erase(dst, str.end());
 }
 
 //! @brief string_replace replace all string instances of 'from' to 'to' into a new output string
-inline std::string string_replace(std::string str, const std::string & from, const std::string & to)
+inline std::string string_replace(std::string_view str, std::string_view from, std::string_view to)
 {
-	string_replace_in_place(str, from, to);
-	return str;
+	std::string out;
+	if (from.empty())
+		out.assign(str);
+	else
+		replace_into(out, str, from, to);
+	return out;
 }
 
 //! @brief to_lower_in_place converts ASCII uppercase characters to lowercase in place
 inline void to_lower_in_place(std::string & str)
 {
-	for (char & c : str)
-	{
-		if (c >= 'A' && c <= 'Z')
-			c = static_cast<char>(c + ('a' - 'A'));
-	}
+	simd::ascii_to_lower(str.data(), str.data() + str.size());
 }
 
 //! @brief to_lower converts ASCII uppercase characters to lowercase and returns by copy
@@ -204,6 +387,102 @@ inline std::string to_lower(std::string str)
 	return str;
 }
 
+//! @brief to_upper_in_place converts ASCII lowercase characters to uppercase in place
+inline void to_upper_in_place(std::string & str)
+{
+	simd::ascii_to_upper(str.data(), str.data() + str.size());
+}
+
+//! @brief to_upper converts ASCII lowercase characters to uppercase and returns by copy
+inline std::string to_upper(std::string str)
+{
+	to_upper_in_place(str);
+	return str;
+}
+
+//! @brief iequals compares two strings ignoring ASCII case, without lowered copies
+inline bool iequals(std::string_view a, std::string_view b) noexcept
+{
+	return a.size() == b.size() && simd::ascii_iequal(a.data(), b.data(), a.size());
+}
+
+//! @brief istarts_with checks whether 'text' starts with 'prefix' ignoring ASCII case
+inline bool istarts_with(std::string_view text, std::string_view prefix) noexcept
+{
+	return text.size() >= prefix.size() && simd::ascii_iequal(text.data(), prefix.data(), prefix.size());
+}
+
+//! @brief ifind returns the first position at or after 'pos' where 'needle' occurs in 'text' ignoring ASCII case, or npos
+inline std::size_t ifind(std::string_view text, std::string_view needle, std::size_t pos = 0) noexcept
+{
+	if (pos > text.size() || needle.size() > text.size() - pos)
+		return std::string_view::npos;
+	if (needle.empty())
+		return pos;
+	const auto head = needle.front();
+	const bool letter = (head | 0x20) >= 'a' && (head | 0x20) <= 'z';
+	const auto lower = letter ? static_cast<char>(head | 0x20) : head;
+	const auto upper = letter ? static_cast<char>(lower & ~0x20) : head;
+	// candidates for the first byte are found with the vectorised two-byte scanner, then verified
+	const auto last = text.data() + (text.size() - needle.size()) + 1;
+	for (auto it = simd::find_first_of2(text.data() + pos, last, lower, upper); it != last; it = simd::find_first_of2(it + 1, last, lower, upper))
+	{
+		if (simd::ascii_iequal(it + 1, needle.data() + 1, needle.size() - 1))
+			return static_cast<std::size_t>(it - text.data());
+	}
+	return std::string_view::npos;
+}
+
+namespace details
+{
+//! @brief lowercase the ASCII letters of eight packed bytes at once
+constexpr std::uint64_t ascii_lower_word(std::uint64_t word) noexcept
+{
+	constexpr std::uint64_t ones = 0x0101010101010101ull;
+	const auto low7 = word & (ones * 0x7F);
+	const auto above_z = low7 + ones * (0x7F - 'Z');
+	const auto from_a = low7 + ones * (0x80 - 'A');
+	const auto upper = ~word & (from_a ^ above_z) & (ones * 0x80);
+	return word | (upper >> 2);
+}
+} // namespace details
+
+//! @brief ihash hashes a string ignoring ASCII case, eight bytes per step; pair it with iequal_to
+//! @note both are transparent, so containers keyed by std::string can be searched with a std::string_view
+struct ihash
+{
+	using is_transparent = void;
+	std::size_t operator()(std::string_view str) const noexcept
+	{
+		std::uint64_t hash = 0x9E3779B97F4A7C15ull ^ str.size();
+		const auto mix = [&hash](std::uint64_t word) {
+			hash = (hash ^ details::ascii_lower_word(word)) * 0xBF58476D1CE4E5B9ull;
+			hash ^= hash >> 31;
+		};
+		std::size_t i = 0;
+		for (; i + 8 <= str.size(); i += 8)
+		{
+			std::uint64_t word;
+			std::memcpy(&word, str.data() + i, 8);
+			mix(word);
+		}
+		if (i < str.size())
+		{
+			std::uint64_t word = 0;
+			std::memcpy(&word, str.data() + i, str.size() - i);
+			mix(word);
+		}
+		return static_cast<std::size_t>(hash);
+	}
+};
+
+//! @brief iequal_to compares strings ignoring ASCII case (transparent)
+struct iequal_to
+{
+	using is_transparent = void;
+	bool operator()(std::string_view a, std::string_view b) const noexcept { return iequals(a, b); }
+};
+
 //! @brief format_grouped_number formats integral values with a grouping separator each three digits
 inline std::string format_grouped_number(long long value, char separator = '.')
 {
@@ -243,14 +522,18 @@ inline const char * whitespaces()
 //! @brief ltrim_in_place left trims in place 'str' of any of the 'chars' characters
 inline std::string & ltrim_in_place(std::string & str, const char * chars = whitespaces())
 {
-	str.erase(0, str.find_first_not_of(chars));
+	const simd::byte_set set(chars);
+	str.erase(0, static_cast<std::size_t>(set.find_not(str.data(), str.data() + str.size()) - str.data()));
 	return str;
 }
 
 //! @brief rtrim_in_place right trims in place 'str' of any of the 'chars' characters
 inline std::string & rtrim_in_place(std::string & str, const char * chars = whitespaces())
 {
-	str.erase(str.find_last_not_of(chars) + 1);
+	const simd::byte_set set(chars);
+	const auto end = str.data() + str.size();
+	const auto last = set.rfind_not(str.data(), end);
+	str.erase(last == end ? 0 : static_cast<std::size_t>(last - str.data()) + 1);
 	return str;
 }
 
@@ -272,6 +555,23 @@ inline std::string & trim_in_place(std::string & str, const char * chars = white
 	return ltrim_in_place(rtrim_in_place(str, chars), chars);
 }
 
+//! @brief trim_view returns the part of 'str' left after trimming any of the 'set' characters from both ends, without copying
+inline std::string_view trim_view(std::string_view str, const simd::byte_set & set)
+{
+	const auto end = str.data() + str.size();
+	const auto first = set.find_not(str.data(), end);
+	if (first == end)
+		return str.substr(str.size());
+	const auto last = set.rfind_not(first, end);
+	return {first, static_cast<std::size_t>(last - first) + 1};
+}
+
+//! @brief trim_view returns the part of 'str' left after trimming any of the 'chars' characters from both ends, without copying
+inline std::string_view trim_view(std::string_view str, const char * chars = whitespaces())
+{
+	return trim_view(str, simd::byte_set(chars));
+}
+
 //! @brief trim right and left trims by copy 'str' of any of the 'chars' characters
 inline std::string trim(std::string str, const char * chars = whitespaces())
 {
@@ -331,4 +631,7 @@ template <typename T> constexpr std::enable_if_t<std::is_floating_point_v<T>, T>
 }
 
 } // namespace msl
+
+//! @brief split views hand out iterators that do not point back into the view
+template <typename Delim> inline constexpr bool std::ranges::enable_borrowed_range<msl::basic_split_view<Delim>> = true;
 #endif // MSL_UTILS_H__
@@ -0,0 +1,6 @@
+#include <msl/async_file.h>
+
+int header_smoke_async_file()
+{
+    return 0;
+}
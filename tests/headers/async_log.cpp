@@ -0,0 +1,6 @@
+#include <msl/async_log.h>
+
+int header_smoke_async_log()
+{
+    return 0;
+}
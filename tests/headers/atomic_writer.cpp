@@ -0,0 +1,6 @@
+#include <msl/atomic_writer.h>
+
+int header_smoke_atomic_writer()
+{
+    return 0;
+}
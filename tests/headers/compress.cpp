@@ -0,0 +1,6 @@
+#include <msl/compress.h>
+
+int header_smoke_compress()
+{
+    return 0;
+}
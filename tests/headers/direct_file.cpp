@@ -0,0 +1,6 @@
+#include <msl/direct_file.h>
+
+int header_smoke_direct_file()
+{
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include <msl/endian.h>
+
+int header_smoke_endian()
+{
+    return 0;
+}
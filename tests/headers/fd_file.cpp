@@ -0,0 +1,6 @@
+#include <msl/fd_file.h>
+
+int header_smoke_fd_file()
+{
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include <msl/file_watcher.h>
+
+int header_smoke_file_watcher()
+{
+    return 0;
+}
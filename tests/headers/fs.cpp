@@ -0,0 +1,6 @@
+#include <msl/fs.h>
+
+int header_smoke_fs()
+{
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include <msl/hash.h>
+
+int header_smoke_hash()
+{
+    return 0;
+}
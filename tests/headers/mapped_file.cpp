@@ -0,0 +1,6 @@
+#include <msl/mapped_file.h>
+
+int header_smoke_mapped_file()
+{
+    return 0;
+}
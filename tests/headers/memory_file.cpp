@@ -0,0 +1,6 @@
+#include <msl/memory_file.h>
+
+int header_smoke_memory_file()
+{
+    return 0;
+}
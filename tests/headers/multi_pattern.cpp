@@ -0,0 +1,6 @@
+#include <msl/multi_pattern.h>
+
+int header_smoke_multi_pattern()
+{
+    return 0;
+}
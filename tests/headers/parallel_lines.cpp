@@ -0,0 +1,6 @@
+#include <msl/parallel_lines.h>
+
+int header_smoke_parallel_lines()
+{
+    return 0;
+}
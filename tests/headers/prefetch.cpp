@@ -0,0 +1,6 @@
+#include <msl/prefetch.h>
+
+int header_smoke_prefetch()
+{
+    return 0;
+}
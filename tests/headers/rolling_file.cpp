@@ -0,0 +1,6 @@
+#include <msl/rolling_file.h>
+
+int header_smoke_rolling_file()
+{
+    return 0;
+}
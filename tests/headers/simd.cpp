@@ -0,0 +1,6 @@
+#include <msl/simd.h>
+
+int header_smoke_simd()
+{
+    return 0;
+}
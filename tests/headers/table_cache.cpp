@@ -0,0 +1,6 @@
+#include <msl/table_cache.h>
+
+int header_smoke_table_cache()
+{
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include <msl/tsv.h>
+
+int header_smoke_tsv()
+{
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include <msl/utf8.h>
+
+int header_smoke_utf8()
+{
+    return 0;
+}
@@ -0,0 +1,16 @@
+#include <msl/file_ptr.h>
+
+#include <optional>
+#include <string>
+
+// built with MSL_FILE_PTR_ENABLE_WIDE_STRING (see tests/CMakeLists.txt)
+int header_smoke_wide_string()
+{
+    const std::optional<std::string> name = msl::file_ptr::w2s(L"wide_é.txt");
+    msl::file_ptr file(std::wstring_view(L"msl_wide_smoke.tmp"), L"wb");
+    if (file)
+        file.string_write(std::wstring_view(L"wide"));
+    const auto stored = file.wfilename();
+    file.open(std::wstring_view(L"msl_wide_smoke.tmp"), L"rb");
+    return name && !stored.empty() ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+#include "test_common.h"
+
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <msl/async_file.h>
+
+namespace
+{
+//! @brief minimal eagerly-started coroutine used to drive async_file awaitables
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+std::span<const std::byte> bytes_of(const std::string & str)
+{
+    return std::as_bytes(std::span(str));
+}
+
+std::string read_all(const std::string & path)
+{
+    msl::file_ptr file(path, "rb");
+    return file.string_read();
+}
+
+void run_callback_round_trip(bool use_io_uring)
+{
+    const std::string path = "msl_async_file_callbacks.tmp";
+    std::remove(path.c_str());
+
+    std::vector<std::string> blocks;
+    for (int i = 0; i < 32; ++i)
+        blocks.push_back(std::string(100, static_cast<char>('a' + i % 26)));
+
+    {
+        msl::async_file file(path, "w+b", {.use_io_uring = use_io_uring});
+        MSL_EXPECT(file.is_open());
+        if (!use_io_uring)
+            MSL_EXPECT(file.backend() == msl::async_file_backend::thread_pool);
+
+        std::atomic<std::size_t> written{0};
+        std::atomic<int> failures{0};
+        for (std::size_t i = 0; i < blocks.size(); ++i) // submitted out of order on purpose
+        {
+            const auto index = blocks.size() - 1 - i;
+            file.write(index * 100, bytes_of(blocks[index]), [&](msl::async_io_result result) {
+                if (!result)
+                    ++failures;
+                written += result.bytes;
+            });
+        }
+        file.wait_idle();
+        MSL_EXPECT(file.pending() == 0);
+        MSL_EXPECT(failures == 0);
+        MSL_EXPECT(written == blocks.size() * 100);
+
+        std::array<std::byte, 150> buffer{};
+        std::promise<msl::async_io_result> done;
+        file.read(3150, buffer, [&](msl::async_io_result result) { done.set_value(result); });
+        const auto result = done.get_future().get();
+        MSL_EXPECT(result && result.bytes == 50); // short read at EOF
+        MSL_EXPECT(std::memcmp(buffer.data(), blocks[31].data(), 50) == 0);
+    }
+
+    std::string expected;
+    for (const auto & block : blocks)
+        expected += block;
+    MSL_EXPECT(read_all(path) == expected);
+
+    std::remove(path.c_str());
+}
+
+void test_callbacks_on_default_backend()
+{
+    run_callback_round_trip(true);
+}
+
+void test_callbacks_on_thread_pool_backend()
+{
+    run_callback_round_trip(false);
+}
+
+detached_task copy_header(msl::async_file & file, std::array<std::byte, 8> & buffer, std::promise<std::size_t> & done)
+{
+    const auto got = co_await file.read(0, buffer);
+    const auto put = co_await file.write(8, std::span<const std::byte>(buffer.data(), got.bytes));
+    done.set_value(put ? put.bytes : 0);
+}
+
+void test_awaitable_read_write()
+{
+    const std::string path = "msl_async_file_awaitable.tmp";
+    {
+        msl::file_ptr file(path, "wb");
+        file.string_write("HEADER01");
+    }
+
+    for (const bool use_io_uring : {true, false})
+    {
+        msl::async_file file(path, "r+b", {.use_io_uring = use_io_uring});
+        std::array<std::byte, 8> buffer{};
+        std::promise<std::size_t> done;
+        auto future = done.get_future();
+        copy_header(file, buffer, done);
+        MSL_EXPECT(future.get() == 8);
+    }
+
+    MSL_EXPECT(read_all(path) == "HEADER01HEADER01");
+    std::remove(path.c_str());
+}
+
+detached_task read_with_owned_file(std::string path, bool use_io_uring, std::promise<std::string> & done)
+{
+    // the file lives in the coroutine frame and is destroyed on the I/O thread that resumed it
+    std::string text;
+    {
+        msl::async_file file(path, "rb", {.use_io_uring = use_io_uring});
+        std::array<std::byte, 8> buffer{};
+        const auto got = co_await file.read(0, buffer);
+        text.assign(reinterpret_cast<const char *>(buffer.data()), got.bytes);
+    }
+    done.set_value(text); // only reached once the destructor returned on the I/O thread
+}
+
+void test_coroutine_destroys_its_own_file()
+{
+    const std::string path = "msl_async_file_owned.tmp";
+    {
+        msl::file_ptr file(path, "wb");
+        file.string_write("OWNEDBY1");
+    }
+
+    for (const bool use_io_uring : {true, false})
+    {
+        for (int round = 0; round < 20; ++round)
+        {
+            std::promise<std::string> done;
+            auto future = done.get_future();
+            read_with_owned_file(path, use_io_uring, done);
+            MSL_EXPECT(future.get() == "OWNEDBY1");
+        }
+    }
+    std::remove(path.c_str());
+}
+
+void test_callbacks_submit_and_wait_on_io_thread()
+{
+    const std::string path = "msl_async_file_chain.tmp";
+    std::remove(path.c_str());
+
+    for (const bool use_io_uring : {true, false})
+    {
+        // a queue depth of one makes every submit from a callback find the ring full
+        msl::async_file file(path, "w+b", {.workers = 1, .queue_depth = 1, .use_io_uring = use_io_uring});
+        const std::string block(64, 'c');
+        std::atomic<int> completed{0};
+        std::promise<void> done;
+        file.write(0, bytes_of(block), [&](msl::async_io_result) {
+            file.wait_idle(); // must not wait for itself
+            for (int i = 1; i <= 8; ++i)
+            {
+                file.write(static_cast<std::uint64_t>(i) * 64, bytes_of(block), [&](msl::async_io_result result) {
+                    if (result && ++completed == 8)
+                        done.set_value();
+                });
+            }
+        });
+        done.get_future().wait();
+        file.wait_idle();
+        MSL_EXPECT(completed == 8);
+        MSL_EXPECT(file.pending() == 0);
+    }
+    MSL_EXPECT(read_all(path) == std::string(9 * 64, 'c'));
+    std::remove(path.c_str());
+}
+
+void test_closed_file_reports_error()
+{
+    msl::async_file file(msl::file_ptr{});
+    MSL_EXPECT(!file.is_open());
+
+    std::array<std::byte, 4> buffer{};
+    bool called = false;
+    file.read(0, buffer, [&](msl::async_io_result result) {
+        called = true;
+        MSL_EXPECT(!result);
+        MSL_EXPECT(result.error == std::errc::bad_file_descriptor);
+    });
+    MSL_EXPECT(called);
+}
+
+detached_task await_failed_submit(msl::async_io_result & out, bool & finished)
+{
+    // the submit fails on this thread: await_suspend must report it synchronously instead of resuming inline
+    msl::async_file file(msl::file_ptr{});
+    std::array<std::byte, 4> buffer{};
+    out = co_await file.read(0, buffer);
+    finished = true;
+}
+
+void test_awaitable_failed_submit_resumes_caller()
+{
+    msl::async_io_result result{};
+    bool finished = false;
+    await_failed_submit(result, finished);
+    MSL_EXPECT(finished);
+    MSL_EXPECT(result.error == std::errc::bad_file_descriptor);
+}
+} // namespace
+
+void run_async_file_tests()
+{
+    test_callbacks_on_default_backend();
+    test_callbacks_on_thread_pool_backend();
+    test_awaitable_read_write();
+    test_coroutine_destroys_its_own_file();
+    test_callbacks_submit_and_wait_on_io_thread();
+    test_closed_file_reports_error();
+    test_awaitable_failed_submit_resumes_caller();
+}
@@ -0,0 +1,121 @@
+#include "test_common.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#include <msl/atomic_writer.h>
+#include <msl/fs.h>
+
+namespace
+{
+std::string read_all(const std::string & path)
+{
+    const auto loaded = msl::load_file(path);
+    return std::string(loaded.data.begin(), loaded.data.end());
+}
+
+bool exists(const std::string & path)
+{
+    return static_cast<bool>(msl::file_ptr(path, "rb"));
+}
+
+void test_atomic_writer_commit_and_abort()
+{
+    {
+        msl::file_ptr file("msl_atomic.tmp", "wb");
+        MSL_EXPECT(file.string_write(std::string("old")) == 3);
+    }
+
+    std::string temp;
+    {
+        msl::atomic_writer writer("msl_atomic.tmp");
+        MSL_EXPECT(static_cast<bool>(writer));
+        temp = writer.temp_path();
+        MSL_EXPECT(writer.file().string_write(std::string("new contents")) == 12);
+        MSL_EXPECT(read_all("msl_atomic.tmp") == "old"); // untouched until commit
+        MSL_EXPECT(!writer.commit());
+        MSL_EXPECT(writer.commit() == std::errc::operation_not_permitted);
+    }
+    MSL_EXPECT(read_all("msl_atomic.tmp") == "new contents");
+    MSL_EXPECT(!exists(temp));
+
+    {
+        msl::atomic_writer writer("msl_atomic.tmp");
+        temp = writer.temp_path();
+        MSL_EXPECT(writer.file().string_write(std::string("discarded")) == 9);
+    }
+    MSL_EXPECT(read_all("msl_atomic.tmp") == "new contents");
+    MSL_EXPECT(!exists(temp));
+
+    msl::atomic_writer missing_dir("msl_atomic_missing_dir/file.tmp");
+    MSL_EXPECT(!missing_dir);
+    MSL_EXPECT(missing_dir.commit() == std::errc::no_such_file_or_directory);
+    std::remove("msl_atomic.tmp");
+}
+
+void test_atomic_commit_group()
+{
+    msl::atomic_commit_group group;
+    for (int i = 0; i < 5; ++i)
+    {
+        auto & writer = group.add("msl_atomic_group_" + std::to_string(i) + ".tmp");
+        MSL_EXPECT(writer.file().string_write("snapshot " + std::to_string(i)) == 10);
+    }
+    MSL_EXPECT(group.size() == 5);
+    MSL_EXPECT(!group.commit());
+    MSL_EXPECT(group.empty());
+    for (int i = 0; i < 5; ++i)
+    {
+        const auto path = "msl_atomic_group_" + std::to_string(i) + ".tmp";
+        MSL_EXPECT(read_all(path) == "snapshot " + std::to_string(i));
+        std::remove(path.c_str());
+    }
+
+    group.add("msl_atomic_group_ok.tmp").file().string_write(std::string("ok"));
+    group.add("msl_atomic_missing_dir/bad.tmp");
+    MSL_EXPECT(group.commit(false) == std::errc::no_such_file_or_directory);
+    MSL_EXPECT(read_all("msl_atomic_group_ok.tmp") == "ok");
+    std::remove("msl_atomic_group_ok.tmp");
+
+    group.add("msl_atomic_group_aborted.tmp");
+    group.abort();
+    MSL_EXPECT(!exists("msl_atomic_group_aborted.tmp"));
+}
+
+void test_atomic_writer_keeps_target_mode()
+{
+    #ifndef _WIN32
+    namespace fs = std::filesystem;
+    constexpr auto owner_only = fs::perms::owner_read | fs::perms::owner_write;
+    constexpr auto shared = owner_only | fs::perms::group_read;
+    {
+        msl::file_ptr file("msl_atomic_mode.tmp", "wb");
+        file.string_write(std::string("secret"));
+    }
+    fs::permissions("msl_atomic_mode.tmp", owner_only);
+    {
+        msl::atomic_writer writer("msl_atomic_mode.tmp");
+        writer.file().string_write(std::string("new secret"));
+        MSL_EXPECT(!writer.commit(false));
+    }
+    MSL_EXPECT(read_all("msl_atomic_mode.tmp") == "new secret");
+    MSL_EXPECT((fs::status("msl_atomic_mode.tmp").permissions() & fs::perms::mask) == owner_only);
+
+    fs::permissions("msl_atomic_mode.tmp", shared);
+    msl::atomic_commit_group group;
+    group.add("msl_atomic_mode.tmp").file().string_write(std::string("grouped"));
+    MSL_EXPECT(!group.commit());
+    MSL_EXPECT((fs::status("msl_atomic_mode.tmp").permissions() & fs::perms::mask) == shared);
+    std::remove("msl_atomic_mode.tmp");
+    #endif
+}
+} // namespace
+
+void run_atomic_writer_tests()
+{
+    test_atomic_writer_commit_and_abort();
+    test_atomic_commit_group();
+    test_atomic_writer_keeps_target_mode();
+}
@@ -0,0 +1,143 @@
+#include "test_common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <msl/compress.h>
+
+namespace
+{
+std::string make_log_text(std::size_t lines)
+{
+    std::string text;
+    for (std::size_t i = 0; i < lines; ++i)
+        text += "[2026-10-19 12:00:" + std::to_string(i % 60) + "] player " + std::to_string(i % 97) + " moved to map 41\n";
+    return text;
+}
+
+std::string make_noise(std::size_t size)
+{
+    std::string noise(size, '\0');
+    std::uint32_t state = 12345;
+    for (auto & c : noise)
+    {
+        state = state * 1664525u + 1013904223u;
+        c = static_cast<char>(state >> 24);
+    }
+    return noise;
+}
+
+bool roundtrip(std::string_view input)
+{
+    std::vector<std::byte> packed(msl::block_compress_bound(input.size()));
+    const auto size = msl::block_compress(std::as_bytes(std::span(input)), packed);
+    if (size == 0)
+        return false;
+    std::vector<std::byte> unpacked(input.size());
+    const auto decoded = msl::block_decompress(std::span<const std::byte>(packed.data(), size), unpacked);
+    return decoded == input.size() && std::string_view(reinterpret_cast<const char *>(unpacked.data()), input.size()) == input;
+}
+
+void test_block_roundtrip()
+{
+    MSL_EXPECT(roundtrip(""));
+    MSL_EXPECT(roundtrip("a"));
+    MSL_EXPECT(roundtrip("abcabcabcabcabc"));
+    MSL_EXPECT(roundtrip(std::string(100000, 'z')));
+    MSL_EXPECT(roundtrip(make_noise(70000)));
+    MSL_EXPECT(roundtrip(make_log_text(3000)));
+
+    const auto text = make_log_text(3000);
+    std::vector<std::byte> packed(msl::block_compress_bound(text.size()));
+    const auto size = msl::block_compress(std::as_bytes(std::span(text)), packed);
+    MSL_EXPECT(size != 0 && size < text.size() / 4);
+
+    std::vector<std::byte> small(size / 2);
+    MSL_EXPECT(msl::block_compress(std::as_bytes(std::span(text)), small) == 0);
+}
+
+void test_block_decode_reference_stream()
+{
+    // hand-encoded LZ4 block: literal 'a', match (offset 1, length 14), final literals "aaaaa"
+    const unsigned char encoded[] = {0x1A, 'a', 0x01, 0x00, 0x50, 'a', 'a', 'a', 'a', 'a'};
+    std::vector<std::byte> out(20);
+    MSL_EXPECT(msl::block_decompress(std::as_bytes(std::span(encoded)), out) == std::optional<std::size_t>(20));
+    MSL_EXPECT(std::string_view(reinterpret_cast<const char *>(out.data()), out.size()) == std::string(20, 'a'));
+
+    std::vector<std::byte> tight(19);
+    MSL_EXPECT(!msl::block_decompress(std::as_bytes(std::span(encoded)), tight));
+
+    const unsigned char bad_offset[] = {0x10, 'a', 0x05, 0x00, 0x00};
+    MSL_EXPECT(!msl::block_decompress(std::as_bytes(std::span(bad_offset)), out));
+
+    // every truncation of a valid stream must be rejected or decode within bounds
+    const auto text = make_log_text(50);
+    std::vector<std::byte> packed(msl::block_compress_bound(text.size()));
+    const auto size = msl::block_compress(std::as_bytes(std::span(text)), packed);
+    std::vector<std::byte> unpacked(text.size());
+    for (std::size_t cut = 0; cut < size; ++cut)
+    {
+        const auto decoded = msl::block_decompress(std::span<const std::byte>(packed.data(), cut), unpacked);
+        MSL_EXPECT(!decoded || *decoded <= text.size());
+    }
+}
+
+void test_compressed_file_roundtrip()
+{
+    const auto text = make_log_text(20000) + make_noise(5000);
+    {
+        msl::compressed_writer writer("msl_compress.tmp", {64 << 10});
+        for (std::size_t pos = 0; pos < text.size(); pos += 1000)
+            MSL_EXPECT(writer.string_write(std::string_view(text).substr(pos, 1000)));
+        MSL_EXPECT(writer.finish());
+        MSL_EXPECT(writer.bytes_in() == text.size());
+        MSL_EXPECT(writer.bytes_out() < text.size() / 2);
+    }
+
+    msl::compressed_reader reader("msl_compress.tmp");
+    char head[100];
+    MSL_EXPECT(reader.read(head, sizeof(head)) == sizeof(head));
+    MSL_EXPECT(std::string_view(head, sizeof(head)) == std::string_view(text).substr(0, 100));
+    const auto rest = reader.read_all();
+    MSL_EXPECT(!reader.error());
+    MSL_EXPECT(reader.eof());
+    MSL_EXPECT(std::string_view(rest.data(), rest.size()) == std::string_view(text).substr(100));
+}
+
+void test_compressed_reader_detects_corruption()
+{
+    {
+        msl::file_ptr file("msl_compress.tmp", "r+b");
+        file.seek(200);
+        char c = 0;
+        MSL_EXPECT(file.fread(&c, 1) == 1);
+        c = static_cast<char>(c ^ 0x5A);
+        file.seek(200);
+        MSL_EXPECT(file.write(static_cast<const void *>(&c), 1) == 1);
+    }
+    msl::compressed_reader reader("msl_compress.tmp");
+    (void)reader.read_all();
+    MSL_EXPECT(reader.error() == std::errc::illegal_byte_sequence);
+
+    {
+        msl::file_ptr file("msl_compress.tmp", "wb");
+        MSL_EXPECT(file.string_write(std::string("not a frame")) == 11);
+    }
+    msl::compressed_reader garbage("msl_compress.tmp");
+    MSL_EXPECT(garbage.error() == std::errc::illegal_byte_sequence);
+    std::remove("msl_compress.tmp");
+}
+} // namespace
+
+void run_compress_tests()
+{
+    test_block_roundtrip();
+    test_block_decode_reference_stream();
+    test_compressed_file_roundtrip();
+    test_compressed_reader_detects_corruption();
+}
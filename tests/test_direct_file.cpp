@@ -0,0 +1,157 @@
+#include "test_common.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <new>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <msl/direct_file.h>
+#include <msl/file_ptr.h>
+#include <msl/fs.h>
+
+namespace
+{
+std::vector<std::byte> make_pattern(std::size_t size)
+{
+    std::vector<std::byte> data(size);
+    for (std::size_t i = 0; i < size; ++i)
+        data[i] = static_cast<std::byte>((i * 7 + i / 4096) & 0xFF);
+    return data;
+}
+
+void test_direct_file_write_unaligned_tail()
+{
+    const auto data = make_pattern(3 * 65536 + 1234);
+    {
+        msl::direct_file file("msl_direct.tmp", msl::direct_mode::write, {4096, 65536});
+        MSL_EXPECT(static_cast<bool>(file));
+        std::size_t pos = 0;
+        for (const std::size_t step : {10u, 5000u, 70000u, 123u, 90000u})
+        {
+            const auto take = std::min(step, data.size() - pos);
+            MSL_EXPECT(file.write(std::span<const std::byte>(data).subspan(pos, take)) == take);
+            pos += take;
+        }
+        MSL_EXPECT(file.write(std::span<const std::byte>(data).subspan(pos)) == data.size() - pos);
+        MSL_EXPECT(file.tell() == data.size());
+        MSL_EXPECT(!file.close());
+    }
+
+    const auto loaded = msl::load_file("msl_direct.tmp");
+    MSL_EXPECT(loaded.data.size() == data.size());
+    MSL_EXPECT(std::equal(data.begin(), data.end(), reinterpret_cast<const std::byte *>(loaded.data.data())));
+}
+
+void test_direct_file_aligned_span_and_read_back()
+{
+    // an aligned caller buffer skips the staging copy
+    constexpr std::size_t size = 8 * 4096;
+    auto * raw = static_cast<std::byte *>(::operator new(size, std::align_val_t{4096}));
+    const auto pattern = make_pattern(size);
+    std::copy(pattern.begin(), pattern.end(), raw);
+    {
+        msl::direct_file file("msl_direct.tmp", msl::direct_mode::write);
+        MSL_EXPECT(file.write(std::span<const std::byte>(raw, size)) == size);
+        MSL_EXPECT(file.write(std::span<const std::byte>(raw, 100)) == 100);
+    }
+    ::operator delete(raw, std::align_val_t{4096});
+
+    msl::direct_file reader("msl_direct.tmp", msl::direct_mode::read, {4096, 16384});
+    std::vector<std::byte> back(size + 100 + 50);
+    std::size_t got = 0;
+    for (std::size_t step = 1; got < back.size(); step = step * 3 + 1)
+    {
+        const auto n = reader.read(std::span<std::byte>(back).subspan(got, std::min(step, back.size() - got)));
+        got += n;
+        if (n == 0)
+            break;
+    }
+    MSL_EXPECT(got == size + 100);
+    // the unaligned tail is EOF: no follow-up read at an unaligned offset, so no EINVAL on direct-I/O filesystems
+    MSL_EXPECT(!reader.error());
+    std::byte past{};
+    MSL_EXPECT(reader.read(std::span<std::byte>(&past, 1)) == 0);
+    MSL_EXPECT(!reader.error());
+    MSL_EXPECT(std::equal(pattern.begin(), pattern.end(), back.begin()));
+    MSL_EXPECT(std::equal(pattern.begin(), pattern.begin() + 100, back.begin() + size));
+
+    MSL_EXPECT(reader.seek(5000));
+    std::byte one{};
+    MSL_EXPECT(reader.read(std::span<std::byte>(&one, 1)) == 1);
+    MSL_EXPECT(one == pattern[5000]);
+    MSL_EXPECT(reader.tell() == 5001);
+
+    MSL_EXPECT(reader.write(std::span<const std::byte>(&one, 1)) == 0); // wrong mode
+    std::remove("msl_direct.tmp");
+
+    msl::direct_file missing("msl_direct_missing.tmp", msl::direct_mode::read);
+    MSL_EXPECT(missing.error() == std::errc::no_such_file_or_directory);
+}
+
+void test_direct_file_typed_span_units_match_file_ptr()
+{
+    const std::array<std::uint32_t, 3> values{1, 2, 3};
+    std::size_t file_ptr_written = 0;
+    {
+        msl::file_ptr file("msl_direct_units.tmp", "wb");
+        file_ptr_written = file.write(std::span<const std::uint32_t>(values));
+    }
+    {
+        msl::direct_file file("msl_direct_units.tmp", msl::direct_mode::write);
+        const auto written = file.write(std::span<const std::uint32_t>(values));
+        MSL_EXPECT(written == sizeof(values)); // bytes
+        MSL_EXPECT(written == file_ptr_written);
+        MSL_EXPECT(!file.close());
+    }
+
+    std::array<std::uint32_t, 4> back{};
+    std::size_t file_ptr_read = 0;
+    {
+        msl::file_ptr file("msl_direct_units.tmp", "rb");
+        file_ptr_read = file.read(std::span<std::uint32_t>(back));
+    }
+    msl::direct_file reader("msl_direct_units.tmp", msl::direct_mode::read);
+    back = {};
+    const auto read = reader.read(std::span<std::uint32_t>(back));
+    MSL_EXPECT(read == values.size()); // elements
+    MSL_EXPECT(read == file_ptr_read);
+    MSL_EXPECT(back[0] == 1 && back[1] == 2 && back[2] == 3);
+    reader.close();
+    std::remove("msl_direct_units.tmp");
+}
+
+void test_direct_file_read_errors_are_not_eof()
+{
+    #ifndef _WIN32
+    // a directory opens read-only but every pread fails (EISDIR): that must not look like an empty file
+    std::filesystem::create_directory("msl_direct_dir.tmp");
+    {
+        msl::direct_file reader("msl_direct_dir.tmp", msl::direct_mode::read);
+        MSL_EXPECT(reader.is_open() && !reader.error());
+        MSL_EXPECT(!reader.seek(0));
+        MSL_EXPECT(reader.error() == std::errc::is_a_directory);
+    }
+    {
+        msl::direct_file reader("msl_direct_dir.tmp", msl::direct_mode::read);
+        std::byte byte{};
+        MSL_EXPECT(reader.read(std::span<std::byte>(&byte, 1)) == 0);
+        MSL_EXPECT(reader.error() == std::errc::is_a_directory);
+        MSL_EXPECT(!reader);
+    }
+    std::filesystem::remove("msl_direct_dir.tmp");
+    #endif
+}
+} // namespace
+
+void run_direct_file_tests()
+{
+    test_direct_file_write_unaligned_tail();
+    test_direct_file_aligned_span_and_read_back();
+    test_direct_file_typed_span_units_match_file_ptr();
+    test_direct_file_read_errors_are_not_eof();
+}
@@ -0,0 +1,72 @@
+#include "test_common.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+
+#include <msl/endian.h>
+
+namespace
+{
+enum class packet_id : std::uint16_t
+{
+    login = 0x0102,
+};
+
+void test_byteswap_integral_values()
+{
+    static_assert(msl::byteswap(std::uint16_t{0x1234}) == 0x3412);
+    static_assert(msl::byteswap(std::uint32_t{0x11223344u}) == 0x44332211u);
+    static_assert(msl::byteswap(std::uint64_t{0x0102030405060708ull}) == 0x0807060504030201ull);
+    static_assert(msl::byteswap(std::uint8_t{0xAB}) == 0xAB);
+
+    MSL_EXPECT(msl::byteswap(std::int32_t{-2}) == std::int32_t{-16777217});
+}
+
+void test_byteswap_value_floats_and_enums()
+{
+    const float value = 1.5f;
+    MSL_EXPECT(msl::byteswap_value(msl::byteswap_value(value)) == value);
+    MSL_EXPECT(std::bit_cast<std::uint32_t>(msl::byteswap_value(value)) == msl::byteswap(std::bit_cast<std::uint32_t>(value)));
+
+    MSL_EXPECT(msl::byteswap_value(packet_id::login) == static_cast<packet_id>(0x0201));
+}
+
+void test_to_from_endian_round_trip()
+{
+    constexpr std::uint32_t value = 0xA1B2C3D4u;
+    static_assert(msl::to_endian<std::endian::native>(value) == value);
+
+    const auto big = msl::to_endian<std::endian::big>(value);
+    const auto little = msl::to_endian<std::endian::little>(value);
+    MSL_EXPECT(msl::from_endian<std::endian::big>(big) == value);
+    MSL_EXPECT(msl::from_endian<std::endian::little>(little) == value);
+    MSL_EXPECT((std::bit_cast<std::array<std::uint8_t, 4>>(big)[0] == 0xA1));
+    MSL_EXPECT((std::bit_cast<std::array<std::uint8_t, 4>>(little)[0] == 0xD4));
+}
+
+void test_convert_endian_in_place_arrays()
+{
+    std::array<std::uint32_t, 5> values = {1, 2, 0x01020304u, 0xFFFFFFFFu, 0};
+    constexpr auto swapped = std::endian::native == std::endian::little ? std::endian::big : std::endian::little;
+
+    msl::convert_endian_in_place<swapped>(std::span(values));
+    MSL_EXPECT(values[0] == 0x01000000u);
+    MSL_EXPECT(values[2] == 0x04030201u);
+
+    msl::convert_endian_in_place<swapped>(std::span(values));
+    MSL_EXPECT(values[2] == 0x01020304u);
+
+    msl::convert_endian_in_place<std::endian::native>(std::span(values));
+    MSL_EXPECT(values[1] == 2);
+}
+} // namespace
+
+void run_endian_tests()
+{
+    test_byteswap_integral_values();
+    test_byteswap_value_floats_and_enums();
+    test_to_from_endian_round_trip();
+    test_convert_endian_in_place_arrays();
+}
@@ -0,0 +1,88 @@
+#include "test_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <msl/fd_file.h>
+
+namespace
+{
+void test_fd_file_write_then_read_lines()
+{
+    {
+        msl::fd_file file("msl_fd_file.tmp", "wb", 16); // a tiny buffer exercises refills and direct transfers
+        MSL_EXPECT(file.is_open());
+        MSL_EXPECT(file.string_write("alpha\nbeta\n") == 11);
+        const std::string long_line(100, 'x');
+        MSL_EXPECT(file.string_write(long_line + "\n") == 101);
+        MSL_EXPECT(file.string_write("\nlast") == 5);
+        MSL_EXPECT(file.tell() == 117);
+        MSL_EXPECT(file.size() == 117);
+        MSL_EXPECT(!file.close());
+    }
+
+    msl::fd_file file("msl_fd_file.tmp", "rb", 16);
+    MSL_EXPECT(file.getline() == std::optional<std::string>("alpha"));
+    std::string line;
+    MSL_EXPECT(file.getline(line) && line == "beta");
+    MSL_EXPECT(file.getline(line) && line == std::string(100, 'x'));
+    MSL_EXPECT(file.getline(line) && line.empty());
+    MSL_EXPECT(file.getline(line) && line == "last");
+    MSL_EXPECT(!file.getline(line));
+    MSL_EXPECT(file.eof());
+
+    MSL_EXPECT(file.seek(6));
+    char beta[4];
+    MSL_EXPECT(file.read(beta, sizeof(beta)) == 4 && std::string(beta, 4) == "beta");
+    MSL_EXPECT(file.tell() == 10);
+    MSL_EXPECT(file.seek(2, SEEK_CUR) && file.tell() == 12);
+    MSL_EXPECT(file.size(true) == 105 && file.remain_size() == 105);
+    const auto three = file.read(3);
+    MSL_EXPECT(three == std::vector<char>({'x', 'x', 'x'}));
+    MSL_EXPECT(file.size(true) == 102); // read-ahead is not counted as consumed
+    const auto rest = file.read(); // 0: the whole remaining file
+    MSL_EXPECT(rest.size() == 102 && std::string(rest.end() - 4, rest.end()) == "last");
+    MSL_EXPECT(file.size(true) == 0 && file.read(10).empty());
+    std::remove("msl_fd_file.tmp");
+}
+
+void test_fd_file_raw_values_and_mixed_access()
+{
+    msl::fd_file file("msl_fd_file_raw.tmp", "w+b");
+    MSL_EXPECT(file.write<std::endian::big>(std::uint32_t{0x11223344}));
+    MSL_EXPECT(file.write(std::uint16_t{7}));
+    const std::vector<std::uint8_t> bytes{1, 2, 3};
+    MSL_EXPECT(file.write(std::span<const std::uint8_t>(bytes)) == 3);
+
+    MSL_EXPECT(file.seek(0));
+    MSL_EXPECT((file.read<std::uint32_t, std::endian::big>() == std::optional<std::uint32_t>(0x11223344)));
+    // a write after buffered read-ahead lands at the logical position
+    MSL_EXPECT(file.write(std::uint16_t{9}));
+    MSL_EXPECT(file.seek(4));
+    MSL_EXPECT(file.read<std::uint16_t>() == std::optional<std::uint16_t>(9));
+    std::uint8_t tail[3]{};
+    MSL_EXPECT(file.read(std::span<std::uint8_t>(tail)) == 3 && tail[2] == 3);
+    MSL_EXPECT(!file.read<std::uint8_t>());
+
+    msl::fd_file moved(std::move(file));
+    MSL_EXPECT(!file.is_open() && moved.is_open());
+    MSL_EXPECT(moved.size() == 9);
+    MSL_EXPECT(!moved.close());
+    std::remove("msl_fd_file_raw.tmp");
+
+    msl::fd_file missing("msl_fd_file_missing.tmp", "r");
+    MSL_EXPECT(!missing && missing.error() == std::errc::no_such_file_or_directory);
+    msl::fd_file bad_mode("msl_fd_file_missing.tmp", "q");
+    MSL_EXPECT(bad_mode.error() == std::errc::invalid_argument);
+}
+} // namespace
+
+void run_fd_file_tests()
+{
+    test_fd_file_write_then_read_lines();
+    test_fd_file_raw_values_and_mixed_access();
+}
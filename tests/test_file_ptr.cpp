@@ -1,7 +1,12 @@
 #include "test_common.h"
 
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -166,6 +171,192 @@ void test_string_read_buffer_behavior()
 
     remove_file_if_exists(path);
 }
+
+void test_write_v_gathers_in_order()
+{
+    const std::string path = "msl_file_ptr_write_v.tmp";
+    remove_file_if_exists(path);
+
+    {
+        msl::file_ptr file(path, "wb");
+        MSL_EXPECT(file.is_open());
+
+        const std::string_view header = "HDR:";
+        const std::string_view body = "payload";
+        const std::string_view trailer = ";END";
+        const std::array<std::span<const std::byte>, 4> parts = {
+            std::as_bytes(std::span(header)),
+            std::span<const std::byte>{},
+            std::as_bytes(std::span(body)),
+            std::as_bytes(std::span(trailer)),
+        };
+
+        MSL_EXPECT(file.string_write("<") == 1); // buffered write must land before the gathered spans
+        MSL_EXPECT(file.write_v(parts) == header.size() + body.size() + trailer.size());
+        MSL_EXPECT(file.tell() == 1 + static_cast<long>(header.size() + body.size() + trailer.size()));
+        MSL_EXPECT(file.string_write(">") == 1);
+    }
+
+    {
+        msl::file_ptr file(path, "rb");
+        MSL_EXPECT(file.string_read() == "<HDR:payload;END>");
+    }
+
+    remove_file_if_exists(path);
+}
+
+void test_read_v_scatters_from_logical_position()
+{
+    const std::string path = "msl_file_ptr_read_v.tmp";
+    remove_file_if_exists(path);
+    write_text_file(path, "0123456789abcdef");
+
+    msl::file_ptr file(path, "rb");
+    char first[2] = {};
+    MSL_EXPECT(file.read(first, sizeof(first)) == sizeof(first)); // fills the stdio buffer past the logical position
+
+    std::array<std::byte, 3> a{};
+    std::array<std::byte, 5> b{};
+    const std::array<std::span<std::byte>, 2> parts = {std::span<std::byte>(a), std::span<std::byte>(b)};
+    MSL_EXPECT(file.read_v(parts) == a.size() + b.size());
+    MSL_EXPECT(std::memcmp(a.data(), "234", a.size()) == 0);
+    MSL_EXPECT(std::memcmp(b.data(), "56789", b.size()) == 0);
+    MSL_EXPECT(file.tell() == 10);
+    MSL_EXPECT(file.string_read() == "abcdef");
+
+    file.seek(12);
+    MSL_EXPECT(file.read_v(parts) == 4); // short read at EOF
+
+    remove_file_if_exists(path);
+}
+
+struct record_header
+{
+    std::uint32_t id;
+    std::uint16_t flags;
+    std::uint16_t count;
+};
+
+void test_typed_value_round_trip()
+{
+    const std::string path = "msl_file_ptr_typed_values.tmp";
+    remove_file_if_exists(path);
+
+    {
+        msl::file_ptr file(path, "wb");
+        MSL_EXPECT(file.write(std::uint32_t{0x01020304u}));
+        MSL_EXPECT(file.write<std::endian::big>(std::uint32_t{0x01020304u}));
+        MSL_EXPECT(file.write<std::endian::little>(2.5));
+        MSL_EXPECT(file.write(record_header{7, 1, 3}));
+    }
+
+    {
+        msl::file_ptr file(path, "rb");
+        MSL_EXPECT(file.size() == 4 + 4 + 8 + sizeof(record_header));
+
+        MSL_EXPECT(file.read<std::uint32_t>() == 0x01020304u);
+        file.seek(4);
+        MSL_EXPECT(file.read<std::uint8_t>() == 0x01); // big endian stores the most significant byte first
+        file.seek(4);
+        MSL_EXPECT((file.read<std::uint32_t, std::endian::big>() == 0x01020304u));
+        MSL_EXPECT((file.read<double, std::endian::little>() == 2.5));
+
+        const auto header = file.read<record_header>();
+        MSL_EXPECT(header.has_value());
+        MSL_EXPECT(header->id == 7 && header->flags == 1 && header->count == 3);
+
+        MSL_EXPECT(!file.read<std::uint32_t>().has_value());
+    }
+
+    remove_file_if_exists(path);
+}
+
+void test_typed_array_round_trip()
+{
+    const std::string path = "msl_file_ptr_typed_arrays.tmp";
+    remove_file_if_exists(path);
+
+    std::vector<std::uint16_t> values(5000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<std::uint16_t>(i * 3);
+
+    {
+        msl::file_ptr file(path, "wb");
+        MSL_EXPECT(file.write_array<std::endian::big>(values) == values.size()); // larger than one staging batch
+        MSL_EXPECT(file.write_array(std::array<std::int32_t, 2>{-1, 42}) == 2);
+    }
+
+    {
+        msl::file_ptr file(path, "rb");
+        MSL_EXPECT(file.read<std::uint8_t>() == 0x00);
+        MSL_EXPECT(file.read<std::uint8_t>() == 0x00);
+        MSL_EXPECT(file.read<std::uint8_t>() == 0x00);
+        MSL_EXPECT(file.read<std::uint8_t>() == 0x03);
+        file.seek(0);
+
+        const auto loaded = file.read_array<std::uint16_t, std::endian::big>(values.size());
+        MSL_EXPECT(loaded == values);
+
+        std::array<std::int32_t, 4> tail{};
+        MSL_EXPECT(file.read_array(std::span(tail)) == 2);
+        MSL_EXPECT(tail[0] == -1 && tail[1] == 42);
+
+        MSL_EXPECT(file.read_array<std::int32_t>(3).empty());
+    }
+
+    remove_file_if_exists(path);
+}
+
+void test_copy_to_respects_positions_and_limit()
+{
+    const std::string src_path = "msl_file_ptr_copy_src.tmp";
+    const std::string dst_path = "msl_file_ptr_copy_dst.tmp";
+    std::string data(200000, '\0');
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<char>('a' + i % 26);
+    {
+        msl::file_ptr file(src_path, "wb");
+        MSL_EXPECT(file.string_write(data) == data.size());
+    }
+
+    {
+        msl::file_ptr src(src_path, "rb");
+        msl::file_ptr dst(dst_path, "wb");
+        char head[10];
+        MSL_EXPECT(src.fread(head, sizeof(head)) == sizeof(head)); // buffered stdio position must be honoured
+        MSL_EXPECT(dst.string_write(std::string("HDR:")) == 4);
+        MSL_EXPECT(src.copy_to(dst, 1000) == 1000);
+        MSL_EXPECT(src.copy_to(dst) == data.size() - 1010);
+        MSL_EXPECT(src.copy_to(dst) == 0);
+        MSL_EXPECT(dst.string_write(std::string(":END")) == 4);
+    }
+
+    std::string copied(data.size() + 10, '\0');
+    msl::file_ptr check(dst_path, "rb");
+    copied.resize(check.fread(copied.data(), copied.size()));
+    MSL_EXPECT(copied == "HDR:" + data.substr(10) + ":END");
+
+    remove_file_if_exists(src_path);
+    remove_file_if_exists(dst_path);
+}
+
+void test_unlocked_fast_paths()
+{
+    {
+        msl::file_ptr file("msl_file_ptr_unlocked.tmp", "wb");
+        MSL_EXPECT(file.string_write_unlocked("first\nsecond") == 12);
+        MSL_EXPECT(file.write_unlocked("\nthird\n", 7) == 7);
+    }
+    msl::file_ptr file("msl_file_ptr_unlocked.tmp", "rb");
+    MSL_EXPECT(file.getline_unlocked() == std::optional<std::string>("first"));
+    MSL_EXPECT(file.getline() == std::optional<std::string>("second"));
+    char third[5];
+    MSL_EXPECT(file.fread_unlocked(third, sizeof(third)) == 5 && std::string_view(third, 5) == "third");
+    MSL_EXPECT(file.getline_unlocked() == std::optional<std::string>(""));
+    MSL_EXPECT(!file.getline_unlocked());
+    file.close();
+    std::remove("msl_file_ptr_unlocked.tmp");
+}
 } // namespace
 
 void run_file_ptr_tests()
@@ -177,4 +368,10 @@ void run_file_ptr_tests()
     test_write_keeps_legacy_printf_syntax();
     test_read_returns_actual_bytes();
     test_string_read_buffer_behavior();
+    test_write_v_gathers_in_order();
+    test_read_v_scatters_from_logical_position();
+    test_typed_value_round_trip();
+    test_typed_array_round_trip();
+    test_copy_to_respects_positions_and_limit();
+    test_unlocked_fast_paths();
 }
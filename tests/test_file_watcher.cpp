@@ -0,0 +1,160 @@
+#include "test_common.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <msl/atomic_writer.h>
+#include <msl/file_watcher.h>
+
+namespace
+{
+void write_file(const std::string & path, const std::string & contents)
+{
+    msl::file_ptr file(path, "wb");
+    MSL_EXPECT(file.string_write(contents) == contents.size());
+}
+
+const msl::file_event * find_event(const std::vector<msl::file_event> & events, const std::string & path)
+{
+    for (const auto & event : events)
+    {
+        if (event.path == path)
+            return &event;
+    }
+    return nullptr;
+}
+
+// a small poll interval keeps the stat-polling fallback fast on platforms without inotify
+const msl::file_watcher_options fast_options{std::chrono::milliseconds(30), std::chrono::milliseconds(500), std::chrono::milliseconds(20)};
+
+void test_file_watcher_reports_coalesced_file_changes()
+{
+    std::filesystem::create_directory("msl_watch_dir");
+    write_file("msl_watch_dir/items.txt", "v1");
+    write_file("msl_watch_dir/other.txt", "x");
+
+    msl::file_watcher watcher(fast_options);
+    MSL_EXPECT(!watcher.watch("msl_watch_dir/items.txt"));
+    MSL_EXPECT(watcher.poll(std::chrono::milliseconds(50)).empty());
+
+    write_file("msl_watch_dir/items.txt", "v2");
+    write_file("msl_watch_dir/items.txt", "v3 longer");
+    write_file("msl_watch_dir/other.txt", "unwatched");
+    const auto events = watcher.poll(std::chrono::milliseconds(2000));
+    MSL_EXPECT(events.size() == 1);
+    MSL_EXPECT(!events.empty() && events[0].path == "msl_watch_dir/items.txt" && events[0].has(msl::file_modified));
+
+    {
+        msl::atomic_writer writer("msl_watch_dir/items.txt");
+        writer.file().string_write(std::string("replaced atomically"));
+        MSL_EXPECT(!writer.commit(false));
+    }
+    const auto replaced = watcher.poll(std::chrono::milliseconds(2000));
+    const auto * event = find_event(replaced, "msl_watch_dir/items.txt");
+    MSL_EXPECT(event && (event->has(msl::file_created) || event->has(msl::file_modified)));
+
+    watcher.unwatch("msl_watch_dir/items.txt");
+    write_file("msl_watch_dir/items.txt", "ignored");
+    MSL_EXPECT(watcher.poll(std::chrono::milliseconds(100)).empty());
+}
+
+void test_file_watcher_directory_callback()
+{
+    msl::file_watcher watcher(fast_options);
+    MSL_EXPECT(!watcher.watch("msl_watch_dir"));
+
+    std::atomic<int> created{0};
+    std::atomic<int> removed{0};
+    watcher.start([&](const msl::file_event & event) {
+        if (event.path == "msl_watch_dir/new.txt" && event.has(msl::file_created))
+            ++created;
+        if (event.path == "msl_watch_dir/other.txt" && event.has(msl::file_removed))
+            ++removed;
+    });
+
+    write_file("msl_watch_dir/new.txt", "hello");
+    std::filesystem::remove("msl_watch_dir/other.txt");
+    for (int i = 0; i < 200 && (created.load() == 0 || removed.load() == 0); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    watcher.stop();
+    MSL_EXPECT(created.load() >= 1);
+    MSL_EXPECT(removed.load() >= 1);
+
+    std::filesystem::remove_all("msl_watch_dir");
+}
+
+void test_file_watcher_survives_directory_replacement()
+{
+    std::filesystem::create_directory("msl_watch_gone");
+    write_file("msl_watch_gone/cfg.txt", "v1");
+
+    msl::file_watcher watcher(fast_options);
+    MSL_EXPECT(!watcher.watch("msl_watch_gone/cfg.txt"));
+
+    std::filesystem::remove_all("msl_watch_gone");
+    const auto gone = watcher.poll(std::chrono::milliseconds(2000));
+    const auto * removed = find_event(gone, "msl_watch_gone/cfg.txt");
+    MSL_EXPECT(removed && removed->has(msl::file_removed));
+
+    // the directory comes back: the watch is re-armed and keeps reporting
+    std::filesystem::create_directory("msl_watch_gone");
+    write_file("msl_watch_gone/cfg.txt", "v2");
+    bool created = false;
+    for (int i = 0; i < 20 && !created; ++i)
+    {
+        const auto events = watcher.poll(std::chrono::milliseconds(200));
+        const auto * event = find_event(events, "msl_watch_gone/cfg.txt");
+        created = event && (event->has(msl::file_created) || event->has(msl::file_modified));
+    }
+    MSL_EXPECT(created);
+
+    watcher.poll(std::chrono::milliseconds(100));
+    write_file("msl_watch_gone/cfg.txt", "v3 longer");
+    const auto changes = watcher.poll(std::chrono::milliseconds(2000));
+    const auto * modified = find_event(changes, "msl_watch_gone/cfg.txt");
+    MSL_EXPECT(modified && modified->has(msl::file_modified));
+
+    std::filesystem::remove_all("msl_watch_gone");
+}
+
+#ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+void test_file_watcher_reports_queue_overflow()
+{
+    // two events per created file (IN_CREATE, IN_CLOSE_WRITE) overflow the kernel queue
+    msl::file_ptr limit_file("/proc/sys/fs/inotify/max_queued_events", "r");
+    const auto limit = limit_file ? std::stoul("0" + limit_file.string_read()) : 0;
+    if (limit == 0 || limit > 40000)
+        return;
+
+    std::filesystem::create_directory("msl_watch_flood");
+    msl::file_watcher watcher(fast_options);
+    MSL_EXPECT(!watcher.watch("msl_watch_flood"));
+    for (unsigned long i = 0; i < limit / 2 + 500; ++i)
+        write_file("msl_watch_flood/" + std::to_string(i), "");
+
+    bool overflow = false;
+    for (int i = 0; i < 50 && !overflow; ++i)
+    {
+        const auto * event = find_event(watcher.poll(std::chrono::milliseconds(200)), "msl_watch_flood");
+        overflow = event && event->has(msl::file_overflow);
+    }
+    MSL_EXPECT(overflow);
+    std::filesystem::remove_all("msl_watch_flood");
+}
+#endif
+} // namespace
+
+void run_file_watcher_tests()
+{
+    test_file_watcher_reports_coalesced_file_changes();
+    test_file_watcher_directory_callback();
+    test_file_watcher_survives_directory_replacement();
+    #ifdef MSL_FILE_WATCHER_HAS_INOTIFY
+    test_file_watcher_reports_queue_overflow();
+    #endif
+}
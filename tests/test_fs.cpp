@@ -0,0 +1,159 @@
+#include "test_common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <msl/fs.h>
+
+namespace
+{
+void write_file(const std::string & path, const std::string & contents)
+{
+    msl::file_ptr file(path, "wb");
+    MSL_EXPECT(file.string_write(contents) == contents.size());
+}
+
+void test_load_files_keeps_order_and_reports_errors()
+{
+    std::vector<std::string> paths;
+    for (int i = 0; i < 40; ++i)
+    {
+        paths.push_back("msl_fs_load_" + std::to_string(i) + ".tmp");
+        write_file(paths.back(), std::string(static_cast<std::size_t>(i) * 37, static_cast<char>('A' + i % 26)));
+    }
+    paths.insert(paths.begin() + 5, "msl_fs_load_missing.tmp");
+
+    const auto results = msl::load_files(paths, 4);
+    MSL_EXPECT(results.size() == paths.size());
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        MSL_EXPECT(results[i].path == paths[i]);
+        if (i == 5)
+        {
+            MSL_EXPECT(!results[i]);
+            MSL_EXPECT(results[i].error == std::errc::no_such_file_or_directory);
+            continue;
+        }
+        const auto index = i < 5 ? i : i - 1;
+        MSL_EXPECT(!results[i].error);
+        MSL_EXPECT(results[i].data.size() == index * 37);
+        MSL_EXPECT(results[i].data.empty() || results[i].data.front() == static_cast<char>('A' + index % 26));
+    }
+
+    for (const auto & path : paths)
+        std::remove(path.c_str());
+}
+
+void test_load_files_single_thread_and_empty_input()
+{
+    write_file("msl_fs_load_single.tmp", "config=1\n");
+
+    const auto results = msl::load_files({"msl_fs_load_single.tmp"}, 1);
+    MSL_EXPECT(results.size() == 1);
+    MSL_EXPECT(std::string(results[0].data.begin(), results[0].data.end()) == "config=1\n");
+
+    MSL_EXPECT(msl::load_files(std::vector<std::string>{}).empty());
+
+    const auto single = msl::load_file("msl_fs_load_single.tmp");
+    MSL_EXPECT(single && single.data.size() == 9);
+
+    std::remove("msl_fs_load_single.tmp");
+}
+
+void test_copy_file_reports_bytes()
+{
+    const std::string data(3 << 20, 'x');
+    write_file("msl_fs_copy_src.tmp", data);
+    write_file("msl_fs_copy_dst.tmp", "previous contents that must be truncated");
+
+    const auto result = msl::copy_file("msl_fs_copy_src.tmp", "msl_fs_copy_dst.tmp");
+    MSL_EXPECT(!result.error);
+    MSL_EXPECT(result.bytes == data.size());
+    const auto copied = msl::load_file("msl_fs_copy_dst.tmp");
+    MSL_EXPECT(copied.data.size() == data.size());
+
+    const auto missing = msl::copy_file("msl_fs_copy_missing.tmp", "msl_fs_copy_dst.tmp");
+    MSL_EXPECT(missing.error == std::errc::no_such_file_or_directory);
+    MSL_EXPECT(missing.bytes == 0);
+
+    std::remove("msl_fs_copy_src.tmp");
+    std::remove("msl_fs_copy_dst.tmp");
+}
+
+void test_copy_file_onto_itself_keeps_contents()
+{
+    write_file("msl_fs_copy_self.tmp", "fifteen bytes!!");
+
+    const auto result = msl::copy_file("msl_fs_copy_self.tmp", "msl_fs_copy_self.tmp");
+    MSL_EXPECT(result.error == std::errc::invalid_argument);
+    MSL_EXPECT(result.bytes == 0);
+    const auto kept = msl::load_file("msl_fs_copy_self.tmp");
+    MSL_EXPECT(std::string(kept.data.begin(), kept.data.end()) == "fifteen bytes!!");
+
+    std::remove("msl_fs_copy_self.tmp");
+}
+
+std::map<std::string, msl::dir_entry> index_listing(const msl::directory_listing & listing)
+{
+    std::map<std::string, msl::dir_entry> index;
+    for (const auto & entry : listing)
+        index.emplace(std::string(entry.path), entry);
+    return index;
+}
+
+void test_scan_directory_lists_tree()
+{
+    std::filesystem::create_directories("msl_scan_root/sub/deeper");
+    write_file("msl_scan_root/a.txt", "hello");
+    write_file("msl_scan_root/sub/b.bin", "0123456789");
+    write_file("msl_scan_root/sub/deeper/c.txt", "");
+    for (int i = 0; i < 50; ++i)
+        write_file("msl_scan_root/sub/deeper/asset_" + std::to_string(i) + ".dat", std::string(static_cast<std::size_t>(i), 'x'));
+
+    const auto serial = msl::scan_directory("msl_scan_root");
+    MSL_EXPECT(!serial.error());
+    MSL_EXPECT(serial.size() == 53);
+    const auto files = index_listing(serial);
+    MSL_EXPECT(files.count("msl_scan_root/a.txt") == 1 && files.at("msl_scan_root/a.txt").size == 5);
+    MSL_EXPECT(files.count("msl_scan_root/sub/b.bin") == 1 && files.at("msl_scan_root/sub/b.bin").size == 10);
+    MSL_EXPECT(files.count("msl_scan_root/sub/deeper/asset_49.dat") == 1 && files.at("msl_scan_root/sub/deeper/asset_49.dat").size == 49);
+    MSL_EXPECT(std::all_of(serial.begin(), serial.end(), [](const auto & e) { return e.type == msl::dir_entry_type::file && e.mtime > 0; }));
+
+    msl::scan_options parallel_options;
+    parallel_options.parallelism = 4;
+    parallel_options.include_directories = true;
+    const auto parallel = msl::scan_directory("msl_scan_root/", parallel_options);
+    MSL_EXPECT(parallel.size() == 55);
+    const auto all = index_listing(parallel);
+    MSL_EXPECT(all.count("msl_scan_root/sub/deeper") == 1 && all.at("msl_scan_root/sub/deeper").type == msl::dir_entry_type::directory);
+    MSL_EXPECT(all.count("msl_scan_root/sub/b.bin") == 1 && all.at("msl_scan_root/sub/b.bin").mtime == files.at("msl_scan_root/sub/b.bin").mtime);
+
+    msl::scan_options shallow;
+    shallow.recursive = false;
+    shallow.stat_entries = false;
+    shallow.include_directories = true;
+    const auto top = index_listing(msl::scan_directory("msl_scan_root", shallow));
+    MSL_EXPECT(top.size() == 2);
+    MSL_EXPECT(top.count("msl_scan_root/sub") == 1 && top.at("msl_scan_root/sub").type == msl::dir_entry_type::directory);
+    MSL_EXPECT(top.count("msl_scan_root/a.txt") == 1 && top.at("msl_scan_root/a.txt").type == msl::dir_entry_type::file);
+
+    std::filesystem::remove_all("msl_scan_root");
+    const auto missing = msl::scan_directory("msl_scan_root");
+    MSL_EXPECT(missing.error() == std::errc::no_such_file_or_directory);
+    MSL_EXPECT(missing.empty());
+}
+} // namespace
+
+void run_fs_tests()
+{
+    test_load_files_keeps_order_and_reports_errors();
+    test_load_files_single_thread_and_empty_input();
+    test_copy_file_reports_bytes();
+    test_copy_file_onto_itself_keeps_contents();
+    test_scan_directory_lists_tree();
+}
@@ -0,0 +1,81 @@
+#include "test_common.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include <msl/hash.h>
+
+namespace
+{
+void test_crc32c_known_values()
+{
+    MSL_EXPECT(msl::crc32c::hash("") == 0x00000000u);
+    MSL_EXPECT(msl::crc32c::hash("123456789") == 0xE3069283u);
+    MSL_EXPECT(msl::crc32c::hash(std::string(32, '\0')) == 0x8A9136AAu);
+
+    // the table path must agree with whatever update() dispatched to
+    const std::string text = "The quick brown fox jumps over the lazy dog, twice over.";
+    const auto raw = reinterpret_cast<const unsigned char *>(text.data());
+    MSL_EXPECT(~msl::details::crc32c_software(0xFFFFFFFFu, raw, text.size()) == msl::crc32c::hash(text));
+}
+
+void test_xxhash64_known_values()
+{
+    MSL_EXPECT(msl::xxhash64::hash("") == 0xEF46DB3751D8E999ULL);
+    MSL_EXPECT(msl::xxhash64::hash("a") == 0xD24EC4F1A98C6E5BULL);
+    MSL_EXPECT(msl::xxhash64::hash("abc") == 0x44BC2CF5AD770999ULL);
+    MSL_EXPECT(msl::xxhash64::hash("abc", 1) != msl::xxhash64::hash("abc"));
+}
+
+void test_streaming_matches_one_shot()
+{
+    std::string data;
+    for (int i = 0; i < 1000; ++i)
+        data += static_cast<char>(i * 31 + 7);
+
+    for (std::size_t step : {1u, 3u, 7u, 31u, 32u, 33u, 100u})
+    {
+        msl::crc32c crc;
+        msl::xxhash64 xxh;
+        for (std::size_t pos = 0; pos < data.size(); pos += step)
+        {
+            const auto part = std::string_view(data).substr(pos, step);
+            crc.update(part);
+            xxh.update(part);
+        }
+        MSL_EXPECT(crc.finish() == msl::crc32c::hash(data));
+        MSL_EXPECT(xxh.finish() == msl::xxhash64::hash(data));
+    }
+}
+
+void test_hash_file_in_chunks()
+{
+    std::string data(300000, '\0');
+    for (std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<char>(i * 13);
+    {
+        msl::file_ptr file("msl_hash_file.tmp", "wb");
+        MSL_EXPECT(file.string_write(data) == data.size());
+    }
+
+    MSL_EXPECT(msl::hash_file<msl::crc32c>("msl_hash_file.tmp", {}, 4096) == msl::crc32c::hash(data));
+    MSL_EXPECT(msl::hash_file("msl_hash_file.tmp", msl::xxhash64(5)) == msl::xxhash64::hash(data, 5));
+
+    msl::file_ptr file("msl_hash_file.tmp", "rb");
+    file.seek(100);
+    MSL_EXPECT(msl::hash_file<msl::xxhash64>(file) == msl::xxhash64::hash(std::string_view(data).substr(100)));
+
+    MSL_EXPECT(!msl::hash_file<msl::crc32c>("msl_hash_missing.tmp"));
+    std::remove("msl_hash_file.tmp");
+}
+} // namespace
+
+void run_hash_tests()
+{
+    test_crc32c_known_values();
+    test_xxhash64_known_values();
+    test_streaming_matches_one_shot();
+    test_hash_file_in_chunks();
+}
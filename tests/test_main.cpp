@@ -11,6 +11,26 @@ void run_traits_tests();
 void run_ptr_tests();
 void run_random_tests();
 void run_bench_tests();
+void run_endian_tests();
+void run_async_log_tests();
+void run_prefetch_tests();
+void run_async_file_tests();
+void run_fs_tests();
+void run_simd_tests();
+void run_mapped_file_tests();
+void run_tsv_tests();
+void run_table_cache_tests();
+void run_hash_tests();
+void run_compress_tests();
+void run_atomic_writer_tests();
+void run_direct_file_tests();
+void run_file_watcher_tests();
+void run_utf8_tests();
+void run_parallel_lines_tests();
+void run_memory_file_tests();
+void run_rolling_file_tests();
+void run_fd_file_tests();
+void run_multi_pattern_tests();
 
 int main()
 {
@@ -26,6 +46,26 @@ int main()
         {"ptr regression tests", run_ptr_tests},
         {"random regression tests", run_random_tests},
         {"bench regression tests", run_bench_tests},
+        {"endian regression tests", run_endian_tests},
+        {"async_log regression tests", run_async_log_tests},
+        {"prefetch regression tests", run_prefetch_tests},
+        {"async_file regression tests", run_async_file_tests},
+        {"fs regression tests", run_fs_tests},
+        {"simd regression tests", run_simd_tests},
+        {"mapped_file regression tests", run_mapped_file_tests},
+        {"tsv regression tests", run_tsv_tests},
+        {"table_cache regression tests", run_table_cache_tests},
+        {"hash regression tests", run_hash_tests},
+        {"compress regression tests", run_compress_tests},
+        {"atomic_writer regression tests", run_atomic_writer_tests},
+        {"direct_file regression tests", run_direct_file_tests},
+        {"file_watcher regression tests", run_file_watcher_tests},
+        {"utf8 regression tests", run_utf8_tests},
+        {"parallel_lines regression tests", run_parallel_lines_tests},
+        {"memory_file regression tests", run_memory_file_tests},
+        {"rolling_file regression tests", run_rolling_file_tests},
+        {"fd_file regression tests", run_fd_file_tests},
+        {"multi_pattern regression tests", run_multi_pattern_tests},
     };
 
     const int failures = msl_test::run_all(tests);
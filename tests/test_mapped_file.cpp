@@ -0,0 +1,54 @@
+#include "test_common.h"
+
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <msl/mapped_file.h>
+
+namespace
+{
+void test_mapped_file_view_and_move()
+{
+    {
+        msl::file_ptr file("msl_mapped_file.tmp", "wb");
+        MSL_EXPECT(file.string_write(std::string("hello mapped world")) == 18);
+    }
+
+    msl::mapped_file mapped("msl_mapped_file.tmp");
+    MSL_EXPECT(mapped.is_open());
+    MSL_EXPECT(mapped.view() == "hello mapped world");
+    MSL_EXPECT(mapped.bytes().size() == 18);
+
+    msl::mapped_file moved(std::move(mapped));
+    MSL_EXPECT(!mapped.is_open());
+    MSL_EXPECT(moved.view() == "hello mapped world");
+
+    moved.reset();
+    MSL_EXPECT(!moved.is_open() && moved.size() == 0);
+    std::remove("msl_mapped_file.tmp");
+}
+
+void test_mapped_file_empty_and_missing()
+{
+    {
+        msl::file_ptr file("msl_mapped_empty.tmp", "wb");
+    }
+    msl::mapped_file empty("msl_mapped_empty.tmp");
+    MSL_EXPECT(empty.is_open());
+    MSL_EXPECT(!empty.is_mapped());
+    MSL_EXPECT(empty.view().empty());
+    std::remove("msl_mapped_empty.tmp");
+
+    msl::mapped_file missing("msl_mapped_missing.tmp");
+    MSL_EXPECT(!missing.is_open());
+    MSL_EXPECT(missing.error() == std::errc::no_such_file_or_directory);
+}
+} // namespace
+
+void run_mapped_file_tests()
+{
+    test_mapped_file_view_and_move();
+    test_mapped_file_empty_and_missing();
+}
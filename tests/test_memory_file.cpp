@@ -0,0 +1,96 @@
+#include "test_common.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <msl/memory_file.h>
+
+namespace
+{
+void test_memory_file_round_trip_and_view()
+{
+    msl::memory_file memory("msl_stage");
+    MSL_EXPECT(memory.is_open());
+    #ifdef MSL_MEMORY_FILE_HAS_MEMFD
+    MSL_EXPECT(memory.is_memfd());
+    #endif
+    MSL_EXPECT(memory.view().empty());
+
+    auto & file = memory.file();
+    MSL_EXPECT(file.string_write(std::string("header\n")) == 7);
+    MSL_EXPECT(file.write<std::endian::little>(std::uint32_t{0x01020304}) == 1);
+    MSL_EXPECT(memory.size() == 11);
+    MSL_EXPECT(memory.str().substr(0, 7) == "header\n");
+    MSL_EXPECT(memory.view()[7] == std::byte{0x04});
+
+    // the existing view follows in-place rewrites of the same size
+    const auto before = memory.str();
+    file.seek(0);
+    file.string_write(std::string("HEADER"));
+    MSL_EXPECT(memory.size() == 11);
+    MSL_EXPECT(before.substr(0, 6) == "HEADER");
+
+    file.seek(0);
+    MSL_EXPECT(file.getline() == std::optional<std::string>("HEADER"));
+    MSL_EXPECT((file.read<std::uint32_t, std::endian::little>() == std::optional<std::uint32_t>(0x01020304)));
+
+    memory.reset();
+    MSL_EXPECT(!memory.is_open() && memory.view().empty());
+}
+
+void test_memory_file_sealing()
+{
+    msl::memory_file plain;
+    #ifdef MSL_MEMORY_FILE_HAS_MEMFD
+    MSL_EXPECT(plain.seal() == std::errc::operation_not_permitted);
+    #else
+    MSL_EXPECT(plain.seal() == std::errc::operation_not_supported);
+    #endif
+
+    msl::memory_file sealable("msl_sealed", {.allow_sealing = true});
+    sealable.file().string_write(std::string("frozen"));
+    #ifdef MSL_MEMORY_FILE_HAS_MEMFD
+    MSL_EXPECT(sealable.str() == "frozen"); // an open view does not block sealing
+    MSL_EXPECT(!sealable.seal());
+    MSL_EXPECT(sealable.is_sealed());
+    sealable.file().string_write(std::string("more"));
+    sealable.file().flush();
+    MSL_EXPECT(sealable.file().error());
+    MSL_EXPECT(sealable.str() == "frozen");
+    #endif
+}
+
+void test_memory_file_move()
+{
+    msl::memory_file source("msl_moved", {.allow_sealing = true});
+    source.file().string_write(std::string("payload"));
+    const auto view = source.view();
+    MSL_EXPECT(source.seal() == std::error_code() || !source.is_memfd());
+    const bool sealed = source.is_sealed();
+
+    // the descriptor, the mapping (or fallback buffer) and the flags move together
+    msl::memory_file moved(std::move(source));
+    MSL_EXPECT(!source.is_open() && !source.is_memfd() && !source.is_sealed() && source.view().empty());
+    MSL_EXPECT(moved.is_open() && moved.is_sealed() == sealed);
+    MSL_EXPECT(moved.view().data() == view.data());
+    MSL_EXPECT(moved.str() == "payload");
+
+    msl::memory_file target("msl_target");
+    target.file().string_write(std::string("replaced"));
+    target = std::move(moved);
+    MSL_EXPECT(!moved.is_open());
+    MSL_EXPECT(target.str() == "payload");
+    target.file().seek(0);
+    MSL_EXPECT(target.file().getline() == std::optional<std::string>("payload"));
+}
+} // namespace
+
+void run_memory_file_tests()
+{
+    test_memory_file_round_trip_and_view();
+    test_memory_file_sealing();
+    test_memory_file_move();
+}
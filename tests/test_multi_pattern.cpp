@@ -0,0 +1,92 @@
+#include "test_common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <msl/multi_pattern.h>
+
+namespace
+{
+void test_find_all_matches_naive_search()
+{
+    // overlapping patterns, prefixes of each other and a pattern that is a suffix of another
+    const std::vector<std::string> patterns = {"he", "she", "his", "hers", "a", "aa", "aab", "ers"};
+    const msl::multi_pattern automaton(patterns);
+    MSL_EXPECT(automaton.size() == patterns.size());
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> pick(0, 5);
+    const char alphabet[] = "ahesrb";
+    for (int round = 0; round < 50; ++round)
+    {
+        std::string text(static_cast<std::size_t>(round * 7), ' ');
+        for (auto & c : text)
+            c = alphabet[pick(generator)];
+
+        std::vector<msl::pattern_match> expected;
+        for (std::size_t end = 1; end <= text.size(); ++end)
+        {
+            std::vector<msl::pattern_match> at_end;
+            for (std::size_t p = 0; p < patterns.size(); ++p)
+            {
+                const auto & pattern = patterns[p];
+                if (pattern.size() <= end && text.compare(end - pattern.size(), pattern.size(), pattern) == 0)
+                    at_end.push_back({end - pattern.size(), pattern.size(), p});
+            }
+            std::sort(at_end.begin(), at_end.end(), [](const auto & a, const auto & b) { return a.length > b.length; });
+            expected.insert(expected.end(), at_end.begin(), at_end.end());
+        }
+        MSL_EXPECT(automaton.find_all(text) == expected);
+        MSL_EXPECT(automaton.contains_any(text) == !expected.empty());
+    }
+}
+
+void test_replace_all_leftmost_longest()
+{
+    const msl::multi_pattern words({"bad", "badword", "word", "ugly"});
+    MSL_EXPECT(words.replace_all("a badword here", "***") == "a *** here");
+    MSL_EXPECT(words.replace_all("bad words, ugly", "#") == "# #s, #");
+    MSL_EXPECT(words.replace_all("clean", "#") == "clean");
+
+    const std::string_view replacements[] = {"b*d", "b*****d", "w**d"};
+    std::string out = "reused";
+    MSL_EXPECT(words.replace_into(out, "bad word ugly badword", replacements) == 3);
+    MSL_EXPECT(out == "b*d w**d ugly b*****d");
+
+    // a candidate is only committed once no longer match starting at or before it can still complete
+    const msl::multi_pattern nested({"abcd", "bc"});
+    MSL_EXPECT(nested.replace_all("abce abcd", "_") == "a_e _");
+    const auto first = nested.find_first("xxabcd");
+    MSL_EXPECT(first.position == 2 && first.length == 4 && first.pattern == 0);
+    MSL_EXPECT(nested.find_first("none").position == msl::multi_pattern::npos);
+}
+
+void test_ignore_case_and_edge_cases()
+{
+    const msl::multi_pattern filter({"Spam", "", "spam", "\xC3\xA9t\xC3\xA9"}, {.ignore_case = true});
+    MSL_EXPECT(filter.ignore_case());
+    MSL_EXPECT(filter.contains_any("no SPAM please"));
+    MSL_EXPECT(filter.replace_all("sPaM and \xC3\xA9T\xC3\xA9", "-") == "- and -");
+    const auto matches = filter.find_all("spamSPAM");
+    MSL_EXPECT(matches.size() == 2 && matches[0].pattern == 0 && matches[1].position == 4);
+
+    const msl::multi_pattern exact({"Spam"});
+    MSL_EXPECT(!exact.contains_any("spam"));
+
+    const msl::multi_pattern none;
+    MSL_EXPECT(none.empty());
+    MSL_EXPECT(!none.contains_any("anything"));
+    MSL_EXPECT(none.replace_all("anything", "x") == "anything");
+}
+} // namespace
+
+void run_multi_pattern_tests()
+{
+    test_find_all_matches_naive_search();
+    test_replace_all_leftmost_longest();
+    test_ignore_case_and_edge_cases();
+}
@@ -0,0 +1,79 @@
+#include "test_common.h"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include <msl/parallel_lines.h>
+
+namespace
+{
+struct log_stats
+{
+    std::size_t lines{0};
+    std::size_t errors{0};
+    std::map<std::string, std::size_t> per_user;
+};
+
+void map_log_line(log_stats & stats, std::string_view line)
+{
+    ++stats.lines;
+    if (line.starts_with("ERROR"))
+        ++stats.errors;
+    if (const auto at = line.find("user="); at != std::string_view::npos)
+        ++stats.per_user[std::string(line.substr(at + 5))];
+}
+
+void reduce_log_stats(log_stats & total, log_stats && part)
+{
+    total.lines += part.lines;
+    total.errors += part.errors;
+    for (const auto & [user, count] : part.per_user)
+        total.per_user[user] += count;
+}
+
+void test_parallel_lines_matches_serial()
+{
+    {
+        msl::file_ptr file("msl_parallel_lines.tmp", "wb");
+        for (int i = 0; i < 1000; ++i)
+        {
+            const std::string line = std::string(i % 10 == 0 ? "ERROR" : "INFO") + " login user=u" + std::to_string(i % 7) + (i % 2 ? "\r\n" : "\n");
+            file.string_write(line);
+        }
+        file.string_write(std::string("INFO last line user=u0")); // no trailing newline
+    }
+
+    const auto serial = msl::parallel_lines<log_stats>("msl_parallel_lines.tmp", map_log_line, reduce_log_stats, 1);
+    MSL_EXPECT(serial.has_value());
+    MSL_EXPECT(serial && serial->lines == 1001 && serial->errors == 100);
+    MSL_EXPECT(serial && serial->per_user.size() == 7 && serial->per_user.at("u0") == 144);
+
+    const msl::mapped_file mapped("msl_parallel_lines.tmp");
+    const auto parallel = msl::parallel_lines<log_stats>(mapped, map_log_line, reduce_log_stats, 8);
+    MSL_EXPECT(serial && parallel.lines == serial->lines && parallel.errors == serial->errors);
+    MSL_EXPECT(serial && parallel.per_user == serial->per_user);
+    std::remove("msl_parallel_lines.tmp");
+}
+
+void test_parallel_lines_empty_and_missing()
+{
+    {
+        msl::file_ptr file("msl_parallel_empty.tmp", "wb");
+    }
+    const auto count = [](std::size_t & n, std::string_view) { ++n; };
+    const auto sum = [](std::size_t & total, std::size_t && part) { total += part; };
+    const auto empty = msl::parallel_lines<std::size_t>("msl_parallel_empty.tmp", count, sum, 4);
+    MSL_EXPECT(empty && *empty == 0);
+    std::remove("msl_parallel_empty.tmp");
+
+    MSL_EXPECT(!msl::parallel_lines<std::size_t>("msl_parallel_missing.tmp", count, sum));
+}
+} // namespace
+
+void run_parallel_lines_tests()
+{
+    test_parallel_lines_matches_serial();
+    test_parallel_lines_empty_and_missing();
+}
@@ -0,0 +1,93 @@
+#include "test_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <msl/prefetch.h>
+
+namespace
+{
+std::string make_contents(std::size_t lines)
+{
+    std::string contents;
+    for (std::size_t i = 0; i < lines; ++i)
+        contents += "replay frame " + std::to_string(i) + '\n';
+    return contents;
+}
+
+void write_file(const std::string & path, const std::string & contents)
+{
+    msl::file_ptr file(path, "wb");
+    MSL_EXPECT(file.string_write(contents) == contents.size());
+}
+
+void test_read_matches_file_across_buffers()
+{
+    const std::string path = "msl_prefetch_read.tmp";
+    const auto contents = make_contents(5000);
+    write_file(path, contents);
+
+    msl::prefetching_reader reader(path, {.buffer_size = 4096, .buffer_count = 3});
+    MSL_EXPECT(reader.is_open());
+
+    std::string collected;
+    std::vector<char> chunk(1000);
+    while (const auto n = reader.read(chunk.data(), chunk.size()))
+        collected.append(chunk.data(), n);
+
+    MSL_EXPECT(collected == contents);
+    MSL_EXPECT(reader.tell() == contents.size());
+    MSL_EXPECT(reader.eof());
+    MSL_EXPECT(!reader.error());
+    MSL_EXPECT(reader.read(16).empty());
+
+    std::remove(path.c_str());
+}
+
+void test_getline_and_span_reads()
+{
+    const std::string path = "msl_prefetch_lines.tmp";
+    const auto contents = make_contents(300) + "no newline";
+    write_file(path, contents);
+
+    msl::prefetching_reader reader(path, {.buffer_size = 64, .buffer_count = 2}); // lines straddle buffers
+    std::uint32_t magic = 0;
+    MSL_EXPECT(reader.read(std::span(&magic, 1)) == 1);
+    MSL_EXPECT(std::string(reinterpret_cast<const char *>(&magic), 4) == "repl");
+
+    MSL_EXPECT(reader.getline() == "ay frame 0");
+    for (std::size_t i = 1; i < 300; ++i)
+        MSL_EXPECT(reader.getline() == "replay frame " + std::to_string(i));
+    MSL_EXPECT(reader.getline() == "no newline");
+    MSL_EXPECT(!reader.getline().has_value());
+
+    std::remove(path.c_str());
+}
+
+void test_starts_from_current_position()
+{
+    const std::string path = "msl_prefetch_offset.tmp";
+    write_file(path, "HEADERbody");
+
+    msl::file_ptr file(path, "rb");
+    file.seek(6);
+    msl::prefetching_reader reader(std::move(file));
+    MSL_EXPECT(reader.read(100) == std::vector<char>({'b', 'o', 'd', 'y'}));
+
+    msl::prefetching_reader missing(std::string_view("msl_prefetch_missing.tmp"));
+    MSL_EXPECT(!missing.is_open());
+    MSL_EXPECT(missing.eof());
+
+    std::remove(path.c_str());
+}
+} // namespace
+
+void run_prefetch_tests()
+{
+    test_read_matches_file_across_buffers();
+    test_getline_and_span_reads();
+    test_starts_from_current_position();
+}
@@ -0,0 +1,74 @@
+#include "test_common.h"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <msl/fs.h>
+#include <msl/rolling_file.h>
+
+namespace
+{
+void test_file_ptr_preallocate()
+{
+    msl::file_ptr file("msl_prealloc.tmp", "wb");
+    MSL_EXPECT(file.string_write(std::string("head")) == 4);
+    MSL_EXPECT(file.tell64() == 4); // preallocate starts from the 64-bit position
+    const auto kept = file.preallocate(1 << 20);
+    if (!kept)
+        MSL_EXPECT(file.size() == 4); // reserved without growing the file
+    else
+        MSL_EXPECT(kept == std::errc::operation_not_supported);
+
+    const auto grown = file.preallocate(1 << 16, false);
+    MSL_EXPECT(!grown);
+    MSL_EXPECT(file.size() == 4 + (1 << 16));
+    file.close();
+    std::remove("msl_prealloc.tmp");
+}
+
+void test_rolling_file_truncates_on_close()
+{
+    std::remove("msl_rolling.tmp");
+    msl::rolling_file_options options;
+    options.extent = 1 << 20;
+    options.writeback_window = 64 << 10;
+    {
+        msl::rolling_file log("msl_rolling.tmp", options);
+        MSL_EXPECT(log.is_open());
+        for (int i = 0; i < 10000; ++i)
+            MSL_EXPECT(log.string_write("line " + std::to_string(i) + "\n") > 0);
+        MSL_EXPECT(log.reserved() >= log.size());
+        MSL_EXPECT(log.reserved() >= options.extent);
+        const auto written = log.size();
+        MSL_EXPECT(!log.close());
+        MSL_EXPECT(msl::load_file("msl_rolling.tmp").data.size() == written);
+    }
+
+    // reopening appends after the existing contents; a write larger than the extent gets its own reservation
+    {
+        options.extent = 4096;
+        msl::rolling_file log("msl_rolling.tmp", options);
+        const auto before = log.size();
+        const std::string big(10000, 'z');
+        MSL_EXPECT(log.string_write(big) == big.size());
+        MSL_EXPECT(log.size() == before + big.size());
+    }
+    const auto loaded = msl::load_file("msl_rolling.tmp");
+    const std::string_view text(loaded.data.data(), loaded.data.size());
+    MSL_EXPECT(text.starts_with("line 0\n") && text.ends_with(std::string(10000, 'z')));
+    MSL_EXPECT(text.find("line 9999\nzzz") != std::string_view::npos);
+    std::remove("msl_rolling.tmp");
+
+    msl::rolling_file missing("msl_missing_dir/rolling.tmp");
+    MSL_EXPECT(!missing.is_open());
+    MSL_EXPECT(missing.error() == std::errc::no_such_file_or_directory);
+}
+} // namespace
+
+void run_rolling_file_tests()
+{
+    test_file_ptr_preallocate();
+    test_rolling_file_truncates_on_close();
+}
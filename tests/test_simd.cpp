@@ -0,0 +1,119 @@
+#include "test_common.h"
+
+#include <string>
+#include <string_view>
+
+#include <msl/simd.h>
+
+namespace
+{
+void test_find_first_of2_every_position()
+{
+    // cover both the 16-byte blocks and the scalar tail
+    for (std::size_t len = 0; len < 70; ++len)
+    {
+        for (std::size_t pos = 0; pos <= len; ++pos)
+        {
+            std::string text(len, 'x');
+            if (pos < len)
+                text[pos] = (pos % 2) ? '\t' : '\n';
+            const char * first = text.data();
+            const char * last = first + text.size();
+            MSL_EXPECT(msl::simd::find_first_of2(first, last, '\t', '\n') == first + pos);
+        }
+    }
+}
+
+void test_find_first_of2_returns_earliest()
+{
+    const std::string text = "0123456789abcdefgh\tij\nkl";
+    const char * first = text.data();
+    const char * last = first + text.size();
+    MSL_EXPECT(msl::simd::find_first_of2(first, last, '\n', '\t') == first + 18);
+    MSL_EXPECT(msl::simd::find_first_of2(first, last, 'z', 'y') == last);
+}
+
+void test_byte_set_matches_scalar_scan()
+{
+    // small sets take the SSE2 path, wide ones the bitmap, high-nibble-heavy ones skip the AVX2 classifier
+    std::string wide;
+    for (int c = 0; c < 256; c += 7)
+        wide.push_back(static_cast<char>(c));
+    const std::string_view sets[] = {";,. \t", "\n", " \f\n\r\t\v", "0123456789abcdefABCDEF", wide, "\x80\xff\x01"};
+    for (const auto chars : sets)
+    {
+        const msl::simd::byte_set set(chars);
+        for (std::size_t len = 0; len < 80; ++len)
+        {
+            for (std::size_t pos = 0; pos <= len; ++pos)
+            {
+                std::string text(len, 'x');
+                if (pos < len)
+                    text[pos] = chars[pos % chars.size()];
+                const char * first = text.data();
+                const char * last = first + text.size();
+                MSL_EXPECT(set.find(first, last) == first + (set.contains('x') ? 0 : pos));
+
+                std::string inside(len, chars[0]);
+                if (pos < len)
+                    inside[pos] = 'x';
+                const bool x_in = set.contains('x');
+                MSL_EXPECT(set.find_not(inside.data(), inside.data() + len) == inside.data() + (x_in ? len : pos));
+                MSL_EXPECT(set.rfind_not(inside.data(), inside.data() + len) == inside.data() + (x_in || pos == len ? len : pos));
+            }
+        }
+    }
+}
+
+void test_byte_set_membership()
+{
+    const msl::simd::byte_set set(";,. \t;;");
+    MSL_EXPECT(set.size() == 5);
+    MSL_EXPECT(set.contains(';') && set.contains('\t') && !set.contains('a') && !set.contains('\0'));
+
+    const msl::simd::byte_set empty;
+    const std::string text = "abc";
+    MSL_EXPECT(empty.empty());
+    MSL_EXPECT(empty.find(text.data(), text.data() + 3) == text.data() + 3);
+    MSL_EXPECT(empty.find_not(text.data(), text.data() + 3) == text.data());
+}
+
+void test_ascii_case_conversion_every_byte()
+{
+    // every byte value at every offset of the 32/16-byte blocks and the scalar tail
+    for (std::size_t len = 0; len < 70; ++len)
+    {
+        for (int value = 0; value < 256; value += 3)
+        {
+            std::string text(len, static_cast<char>(value));
+            for (std::size_t i = 0; i < len; i += 5)
+                text[i] = static_cast<char>(i * 7);
+            std::string lower = text;
+            std::string upper = text;
+            msl::simd::ascii_to_lower(lower.data(), lower.data() + len);
+            msl::simd::ascii_to_upper(upper.data(), upper.data() + len);
+            for (std::size_t i = 0; i < len; ++i)
+            {
+                const auto c = static_cast<unsigned char>(text[i]);
+                MSL_EXPECT(static_cast<unsigned char>(lower[i]) == ((c >= 'A' && c <= 'Z') ? c + 32 : c));
+                MSL_EXPECT(static_cast<unsigned char>(upper[i]) == ((c >= 'a' && c <= 'z') ? c - 32 : c));
+            }
+            MSL_EXPECT(msl::simd::ascii_iequal(lower.data(), upper.data(), len));
+            if (len > 0)
+            {
+                upper[len - 1] = static_cast<char>(upper[len - 1] ^ 0x40);
+                MSL_EXPECT(!msl::simd::ascii_iequal(lower.data(), upper.data(), len));
+            }
+        }
+    }
+}
+} // namespace
+
+void run_simd_tests()
+{
+    test_find_first_of2_every_position();
+    test_find_first_of2_returns_earliest();
+    test_byte_set_matches_scalar_scan();
+    test_byte_set_membership();
+    test_ascii_case_conversion_every_byte();
+}
@@ -0,0 +1,89 @@
+#include "test_common.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include <msl/table_cache.h>
+#include <msl/tsv.h>
+
+namespace
+{
+struct item_row
+{
+    std::uint32_t vnum;
+    std::int32_t price;
+    msl::table_string name;
+};
+
+void write_file(const std::string & path, const std::string & contents)
+{
+    msl::file_ptr file(path, "wb");
+    MSL_EXPECT(file.string_write(contents) == contents.size());
+}
+
+void build_items(msl::table_cache_writer<item_row> & writer, std::string_view text)
+{
+    msl::tsv_reader reader(text);
+    reader.for_each([&](const msl::tsv_row & row) {
+        writer.add_row({row.get<std::uint32_t>(0).value_or(0), row.get<std::int32_t>(1).value_or(0), writer.add_string(row[2])});
+    });
+}
+
+void test_table_cache_build_then_load()
+{
+    write_file("msl_table_source.tmp", "1\t100\tsword\n2\t250\tshield\n3\t100\tsword\n");
+    std::remove("msl_table_cache.tmp");
+
+    msl::table_cache<item_row> cache;
+    MSL_EXPECT(cache.open("msl_table_cache.tmp", "msl_table_source.tmp", 1) == msl::table_cache_status::missing);
+    MSL_EXPECT(!cache);
+
+    MSL_EXPECT(cache.open_or_build("msl_table_cache.tmp", "msl_table_source.tmp", 1, build_items) == msl::table_cache_status::ok);
+    MSL_EXPECT(cache.rebuilt());
+    MSL_EXPECT(cache.size() == 3);
+    MSL_EXPECT(cache[1].vnum == 2 && cache[1].price == 250);
+    MSL_EXPECT(cache.string(cache[1].name) == "shield");
+    MSL_EXPECT(cache[0].name.offset == cache[2].name.offset); // deduplicated heap
+
+    msl::table_cache<item_row> warm;
+    MSL_EXPECT(warm.open_or_build("msl_table_cache.tmp", "msl_table_source.tmp", 1, build_items) == msl::table_cache_status::ok);
+    MSL_EXPECT(!warm.rebuilt());
+    MSL_EXPECT(warm.string(warm[2].name) == "sword");
+    MSL_EXPECT(warm.source_stamp().hash == msl::stamp_table_source("msl_table_source.tmp")->hash);
+
+    MSL_EXPECT(warm.open("msl_table_cache.tmp", "msl_table_source.tmp", 2) == msl::table_cache_status::incompatible);
+}
+
+void test_table_cache_invalidation()
+{
+    msl::table_cache<item_row> cache;
+    MSL_EXPECT(cache.open_or_build("msl_table_cache.tmp", "msl_table_source.tmp", 1, build_items) == msl::table_cache_status::ok);
+
+    // same size (and possibly the same mtime tick): only the content hash can tell
+    write_file("msl_table_source.tmp", "1\t100\tsword\n2\t999\tshield\n3\t100\tsword\n");
+    msl::table_cache<item_row> changed;
+    const auto status = changed.open("msl_table_cache.tmp", "msl_table_source.tmp", 1);
+    MSL_EXPECT(status == msl::table_cache_status::stale);
+
+    write_file("msl_table_source.tmp", "7\t1\tbow\n");
+    MSL_EXPECT(changed.open("msl_table_cache.tmp", "msl_table_source.tmp", 1, msl::table_cache_validation::metadata) == msl::table_cache_status::stale);
+    MSL_EXPECT(changed.open_or_build("msl_table_cache.tmp", "msl_table_source.tmp", 1, build_items) == msl::table_cache_status::ok);
+    MSL_EXPECT(changed.rebuilt() && changed.size() == 1);
+    MSL_EXPECT(changed.string(changed[0].name) == "bow");
+
+    write_file("msl_table_cache.tmp", "MSLTBLC");
+    MSL_EXPECT(changed.open("msl_table_cache.tmp", "msl_table_source.tmp", 1) == msl::table_cache_status::corrupt);
+
+    std::remove("msl_table_source.tmp");
+    MSL_EXPECT(changed.open_or_build("msl_table_cache.tmp", "msl_table_source.tmp", 1, build_items) == msl::table_cache_status::source_error);
+    std::remove("msl_table_cache.tmp");
+}
+} // namespace
+
+void run_table_cache_tests()
+{
+    test_table_cache_build_then_load();
+    test_table_cache_invalidation();
+}
@@ -0,0 +1,121 @@
+#include "test_common.h"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <msl/tsv.h>
+
+namespace
+{
+void test_tsv_reader_cells_and_line_endings()
+{
+    const std::string_view text = "1\tsword\t12.5\r\n\n2\tshield\t\n3\t\tx";
+    msl::tsv_reader reader(text);
+    msl::tsv_row row;
+
+    MSL_EXPECT(reader.next(row));
+    MSL_EXPECT(row.size() == 3);
+    MSL_EXPECT(row[1] == "sword");
+    MSL_EXPECT(row[2] == "12.5");
+    MSL_EXPECT(row.line() == "1\tsword\t12.5");
+    MSL_EXPECT(row.offset() == 0);
+
+    MSL_EXPECT(reader.next(row));
+    MSL_EXPECT(row.size() == 3);
+    MSL_EXPECT(row[0] == "2");
+    MSL_EXPECT(row[2].empty());
+
+    MSL_EXPECT(reader.next(row));
+    MSL_EXPECT(row.size() == 3);
+    MSL_EXPECT(row[1].empty());
+    MSL_EXPECT(row[2] == "x");
+    MSL_EXPECT(row[2].data() == text.data() + text.size() - 1);
+
+    MSL_EXPECT(!reader.next(row));
+
+    reader.rewind();
+    std::size_t lines = 0;
+    reader.for_each([&](const msl::tsv_row &) { ++lines; });
+    MSL_EXPECT(lines == 3);
+
+    msl::tsv_reader keep_empty(text, {'\t', false});
+    lines = 0;
+    keep_empty.for_each([&](const msl::tsv_row &) { ++lines; });
+    MSL_EXPECT(lines == 4);
+}
+
+void test_tsv_row_typed_get()
+{
+    msl::tsv_reader reader(std::string_view("42\t-7\t3.25\ttrue\tabc\t300"));
+    msl::tsv_row row;
+    MSL_EXPECT(reader.next(row));
+    MSL_EXPECT(row.get<int>(0) == 42);
+    MSL_EXPECT(row.get<long long>(1) == -7);
+    MSL_EXPECT(row.get<double>(2) == 3.25);
+    MSL_EXPECT(row.get<bool>(3) == true);
+    MSL_EXPECT(row.get<std::string>(4) == std::string("abc"));
+    MSL_EXPECT(!row.get<int>(4));
+    MSL_EXPECT(!row.get<unsigned char>(5)); // out of range
+    MSL_EXPECT(!row.get<int>(6)); // missing cell
+    MSL_EXPECT(msl::parse_cell<int>("12x") == std::nullopt);
+}
+
+void test_tsv_reader_mapped_file_and_parallel()
+{
+    std::string contents;
+    long long expected = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        contents += std::to_string(i) + ";item" + std::to_string(i) + "\n";
+        expected += i;
+    }
+    {
+        msl::file_ptr file("msl_tsv_parallel.tmp", "wb");
+        MSL_EXPECT(file.string_write(contents) == contents.size());
+    }
+
+    msl::tsv_reader reader(msl::mapped_file("msl_tsv_parallel.tmp"), {';'});
+    MSL_EXPECT(static_cast<bool>(reader) && !reader.error());
+    MSL_EXPECT(reader.text().size() == contents.size());
+
+    // a mapping failure is reported instead of looking like an empty table
+    msl::tsv_reader missing(msl::mapped_file("msl_tsv_missing.tmp"));
+    MSL_EXPECT(!missing);
+    MSL_EXPECT(missing.error() == std::errc::no_such_file_or_directory);
+    MSL_EXPECT(static_cast<bool>(msl::tsv_reader("a\tb\n")));
+
+    std::vector<long long> sums(4, 0);
+    std::vector<std::size_t> counts(4, 0);
+    bool offsets_ok = true;
+    const auto chunks = reader.parallel_for_each([&](std::size_t chunk, const msl::tsv_row & row) {
+        sums[chunk] += row.get<long long>(0).value_or(0);
+        ++counts[chunk];
+        if (reader.text().substr(row.offset(), row.line().size()) != row.line())
+            offsets_ok = false;
+    }, 4);
+    MSL_EXPECT(chunks >= 1 && chunks <= 4);
+
+    long long total = 0;
+    std::size_t rows = 0;
+    for (std::size_t i = 0; i < sums.size(); ++i)
+    {
+        total += sums[i];
+        rows += counts[i];
+    }
+    MSL_EXPECT(total == expected);
+    MSL_EXPECT(rows == 1000);
+    MSL_EXPECT(offsets_ok);
+
+    std::remove("msl_tsv_parallel.tmp");
+}
+} // namespace
+
+void run_tsv_tests()
+{
+    test_tsv_reader_cells_and_line_endings();
+    test_tsv_row_typed_get();
+    test_tsv_reader_mapped_file_and_parallel();
+}
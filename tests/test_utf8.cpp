@@ -0,0 +1,73 @@
+#include "test_common.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <msl/utf8.h>
+
+namespace
+{
+void test_utf8_round_trip()
+{
+    // long ASCII runs exercise the vector path, the tail and the multi-byte forms the scalar path
+    const std::wstring wide = L"items/item_proto_0123456789abcdef.txt é中\U0001F600 tail after the emoji, padded to 16+";
+    const std::string utf8 = "items/item_proto_0123456789abcdef.txt \xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80 tail after the emoji, padded to 16+";
+
+    std::string encoded;
+    MSL_EXPECT(!msl::utf8_from_wide(wide, encoded));
+    MSL_EXPECT(encoded == utf8);
+
+    std::wstring decoded;
+    MSL_EXPECT(!msl::wide_from_utf8(utf8, decoded));
+    MSL_EXPECT(decoded == wide);
+
+    // reused buffers shrink to the converted size
+    MSL_EXPECT(!msl::utf8_from_wide(L"abc", encoded));
+    MSL_EXPECT(encoded == "abc");
+    MSL_EXPECT(!msl::wide_from_utf8("", decoded));
+    MSL_EXPECT(decoded.empty());
+}
+
+void test_utf8_caller_buffers()
+{
+    std::array<char, 8> small{};
+    const auto partial = msl::utf8_from_wide(L"abcdefgé", std::span<char>(small));
+    MSL_EXPECT(partial.error == std::errc::no_buffer_space);
+    MSL_EXPECT(partial.read == 7 && partial.written == 7);
+    MSL_EXPECT(std::string_view(small.data(), partial.written) == "abcdefg");
+
+    std::array<wchar_t, 4> wide{};
+    const auto ok = msl::wide_from_utf8("\xC3\xA9t\xC3\xA9", std::span<wchar_t>(wide));
+    MSL_EXPECT(!ok.error);
+    MSL_EXPECT(ok.read == 5 && ok.written == 3);
+    MSL_EXPECT(std::wstring_view(wide.data(), ok.written) == L"été");
+}
+
+void test_utf8_rejects_invalid_input()
+{
+    std::wstring decoded;
+    MSL_EXPECT(msl::wide_from_utf8("\xC0\xAF", decoded) == std::errc::illegal_byte_sequence);         // overlong '/'
+    MSL_EXPECT(msl::wide_from_utf8("\xED\xA0\x80", decoded) == std::errc::illegal_byte_sequence);     // surrogate
+    MSL_EXPECT(msl::wide_from_utf8("\xF4\x90\x80\x80", decoded) == std::errc::illegal_byte_sequence); // above U+10FFFF
+    MSL_EXPECT(msl::wide_from_utf8("ab\xE4\xB8", decoded) == std::errc::illegal_byte_sequence);       // truncated
+    MSL_EXPECT(msl::wide_from_utf8("\x80", decoded) == std::errc::illegal_byte_sequence);             // stray continuation
+
+    std::array<wchar_t, 8> wide{};
+    const auto bad = msl::wide_from_utf8("ok\xFFok", std::span<wchar_t>(wide));
+    MSL_EXPECT(bad.error == std::errc::illegal_byte_sequence);
+    MSL_EXPECT(bad.read == 2 && bad.written == 2);
+
+    std::string encoded;
+    std::wstring lone_surrogate = L"a";
+    lone_surrogate.push_back(static_cast<wchar_t>(0xD800));
+    MSL_EXPECT(msl::utf8_from_wide(lone_surrogate, encoded) == std::errc::illegal_byte_sequence);
+}
+} // namespace
+
+void run_utf8_tests()
+{
+    test_utf8_round_trip();
+    test_utf8_caller_buffers();
+    test_utf8_rejects_invalid_input();
+}
@@ -2,9 +2,13 @@
 
 #include <array>
 #include <climits>
+#include <iterator>
+#include <ranges>
 #include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <msl/utils.h>
@@ -46,6 +50,33 @@ void test_to_lower_in_place_and_copy()
     MSL_EXPECT(lowered == "mixed case!");
 }
 
+void test_case_insensitive_lookups()
+{
+    MSL_EXPECT(msl::to_upper("Player_01 [GM]") == "PLAYER_01 [GM]");
+    const std::string long_name = "The_Quick_Brown_Fox_Jumps_Over_The_Lazy_Dog_\xC3\x84";
+    MSL_EXPECT(msl::to_lower(long_name) == "the_quick_brown_fox_jumps_over_the_lazy_dog_\xC3\x84");
+
+    MSL_EXPECT(msl::iequals(long_name, "THE_QUICK_BROWN_FOX_JUMPS_OVER_THE_LAZY_DOG_\xC3\x84"));
+    MSL_EXPECT(!msl::iequals(long_name, "THE_QUICK_BROWN_FOX_JUMPS_OVER_THE_LAZY_DOG_\xC3\xA4"));
+    MSL_EXPECT(!msl::iequals("a", "ab") && msl::iequals("", ""));
+    MSL_EXPECT(!msl::iequals("[", "{") && !msl::iequals("@", "`"));
+    MSL_EXPECT(msl::istarts_with("/WARP 100 200", "/warp") && !msl::istarts_with("/wa", "/warp"));
+
+    MSL_EXPECT(msl::ifind(long_name, "LAZY") == 35);
+    MSL_EXPECT(msl::ifind(long_name, "the", 1) == 31);
+    MSL_EXPECT(msl::ifind(long_name, "_dog_\xC3\x84") == 39);
+    MSL_EXPECT(msl::ifind(long_name, "cat") == std::string_view::npos);
+    MSL_EXPECT(msl::ifind("abc", "") == 0 && msl::ifind("abc", "", 4) == std::string_view::npos);
+
+    const msl::ihash hash;
+    MSL_EXPECT(hash("GameMaster_Longer_Than_8") == hash("gamemaster_longer_than_8"));
+    MSL_EXPECT(hash("abc") != hash("abd"));
+    std::unordered_map<std::string, int, msl::ihash, msl::iequal_to> players{{"Alice", 1}, {"bob", 2}};
+    const auto found = players.find(std::string_view("ALICE"));
+    MSL_EXPECT(found != players.end() && found->second == 1);
+    MSL_EXPECT(players.contains(std::string_view("BoB")));
+}
+
 void test_format_grouped_number_default_separator()
 {
     MSL_EXPECT(msl::format_grouped_number(0) == "0");
@@ -147,6 +178,37 @@ void test_string_replace_string()
     std::string s = "foo bar foo";
     msl::string_replace_in_place(s, std::string{"foo"}, std::string{"baz"});
     MSL_EXPECT(s == "baz bar baz");
+    msl::string_replace_in_place(s, std::string{"a"}, std::string{"o"});
+    MSL_EXPECT(s == "boz bor boz");
+}
+
+void test_string_replace_resizing()
+{
+    // shrinking, growing and overlapping patterns, checked against a naive find/replace loop
+    const std::string_view texts[] = {"", "aaaa", "a--b--c--", "----", "x-y", "no match here"};
+    const std::pair<std::string_view, std::string_view> rules[] = {{"--", ""}, {"--", "-"}, {"--", "<=>"}, {"aa", "a"}, {"a", "aaa"}, {"-", "--"},
+        {"--", "=="}, {"a", "b"}, {"-", "+"}}; // equal lengths rewrite the kept text in place
+    for (const auto text : texts)
+    {
+        for (const auto & [from, to] : rules)
+        {
+            std::string expected(text);
+            for (auto pos = expected.find(from); pos != std::string::npos; pos = expected.find(from, pos + to.size()))
+                expected.replace(pos, from.size(), to);
+
+            std::string in_place(text);
+            msl::string_replace_in_place(in_place, from, to);
+            MSL_EXPECT(in_place == expected);
+            MSL_EXPECT(msl::string_replace(text, from, to) == expected);
+        }
+    }
+
+    std::string out = "stale contents that are longer";
+    MSL_EXPECT(msl::replace_into(out, "DROP TABLE x; DROP TABLE y;", "DROP", "--") == 2);
+    MSL_EXPECT(out == "-- TABLE x; -- TABLE y;");
+    MSL_EXPECT(msl::replace_into(out, "clean", "DROP", "--") == 0 && out == "clean");
+    MSL_EXPECT(msl::string_count("abababa", "aba") == 2);
+    MSL_EXPECT(msl::string_count("abc", "") == 0);
 }
 
 void test_string_split_any()
@@ -163,6 +225,42 @@ void test_string_split_any()
     MSL_EXPECT(single[0] == "hello");
 }
 
+void test_split_view_is_lazy_and_allocation_free()
+{
+    static_assert(std::ranges::forward_range<decltype(msl::split_view("", ','))>);
+    static_assert(std::ranges::borrowed_range<decltype(msl::split_any("", ",;"))>);
+
+    std::vector<std::string_view> tokens;
+    for (const auto token : msl::split_view(std::string_view("move 10,20,,"), ','))
+        tokens.push_back(token);
+    MSL_EXPECT((tokens == std::vector<std::string_view>{"move 10", "20", "", ""}));
+
+    const std::string_view command = "say::hello::world";
+    MSL_EXPECT(std::ranges::distance(msl::split_view(command, "::")) == 3);
+    MSL_EXPECT(*msl::split_view(command, "::").begin() == "say");
+    MSL_EXPECT(std::ranges::distance(msl::split_view(command, "")) == 1);
+    MSL_EXPECT(std::ranges::distance(msl::split_view("", ',')) == 1);
+
+    // the reused container keeps its storage across calls
+    MSL_EXPECT(msl::split_any_into(tokens, "a b\tc", " \t") == 3);
+    const auto * storage = tokens.data();
+    MSL_EXPECT(msl::split_into(tokens, "x|y", '|') == 2);
+    MSL_EXPECT(tokens.data() == storage && tokens[1] == "y");
+    MSL_EXPECT(msl::split_into(tokens, "k=>v", "=>") == 2 && tokens[0] == "k");
+
+    std::vector<std::string> owned;
+    MSL_EXPECT(msl::split_into(owned, "p,q", ',') == 2 && owned[1] == "q");
+
+    // a prebuilt delimiter set is reused across calls
+    const msl::simd::byte_set delims(";,. \t");
+    const std::string line = "alpha, beta;gamma.\tdelta-epsilon zeta,eta;theta iota";
+    MSL_EXPECT(std::ranges::distance(msl::split_any(line, delims)) == 10);
+    MSL_EXPECT(msl::string_split_any(line, ";,. \t").size() == 10);
+    MSL_EXPECT(msl::trim_view("  \t padded value \r\n") == "padded value");
+    MSL_EXPECT(msl::trim_view(" \t ").empty());
+    MSL_EXPECT(msl::trim_view("--x--", delims).size() == 5);
+}
+
 void test_calculate_percentage()
 {
     MSL_EXPECT(msl::calculate_percentage(50, 100) == 50.0);
@@ -191,6 +289,25 @@ void test_split_join_roundtrip()
     const auto split = msl::string_split(joined, ',');
     MSL_EXPECT(split == v);
 }
+
+void test_line_chunks()
+{
+    const std::string_view text = "a\nbb\nccc\ndddd\neeeee";
+    const auto chunks = msl::line_chunks(text, 3);
+    MSL_EXPECT(!chunks.empty() && chunks.size() <= 3);
+    std::string joined;
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        if (i + 1 < chunks.size())
+            MSL_EXPECT(chunks[i].back() == '\n');
+        joined += chunks[i];
+    }
+    MSL_EXPECT(joined == text);
+
+    MSL_EXPECT(msl::line_chunks("", 4).empty());
+    MSL_EXPECT(msl::line_chunks("no newline", 4).size() == 1);
+    MSL_EXPECT(msl::line_chunks(text, 0).size() == 1);
+}
 } // namespace
 
 void run_utils_tests()
@@ -199,6 +316,7 @@ void run_utils_tests()
     test_split_string_regular_token();
     test_split_char_token();
     test_to_lower_in_place_and_copy();
+    test_case_insensitive_lookups();
     test_format_grouped_number_default_separator();
     test_format_grouped_number_custom_separator_and_limits();
     test_string_join_with_ranges();
@@ -209,8 +327,11 @@ void run_utils_tests()
     test_trim_idempotent();
     test_string_replace_char();
     test_string_replace_string();
+    test_string_replace_resizing();
     test_string_split_any();
+    test_split_view_is_lazy_and_allocation_free();
     test_calculate_percentage();
     test_value_from_percentage();
     test_split_join_roundtrip();
+    test_line_chunks();
 }